@@ -325,6 +325,9 @@ public:
 
             if (_options->count("check-locks"))
             {
+#ifndef CHAINBASE_CHECK_LOCKS
+                wlog("check-locks has no effect, the node is built without CHAINBASE_CHECK_LOCKS");
+#endif
                 _chain_db->set_require_locking(true);
             }
 
@@ -337,6 +340,22 @@ public:
                 _shared_dir = _data_dir / "blockchain";
             }
 
+            chainbase::segment_mapping_options mapping_options;
+            mapping_options.huge_pages = _options->count("shared-file-huge-pages") > 0;
+            mapping_options.prefault = _options->count("shared-file-prefault") > 0;
+
+            const std::string access_hint = _options->at("shared-file-access-hint").as<std::string>();
+            if (access_hint == "random")
+                mapping_options.access = chainbase::segment_mapping_options::random_access;
+            else if (access_hint == "sequential")
+                mapping_options.access = chainbase::segment_mapping_options::sequential_access;
+            else if (access_hint == "willneed")
+                mapping_options.access = chainbase::segment_mapping_options::willneed_access;
+            else
+                FC_ASSERT(access_hint == "normal", "Unknown shared-file-access-hint ${h}", ("h", access_hint));
+
+            _chain_db->set_mapping_options(mapping_options);
+
             if (_options->count("disable_get_block"))
             {
                 _self->_disable_get_block = true;
@@ -354,6 +373,13 @@ public:
 
                 _chain_db->set_flush_interval(_options->at("flush").as<uint32_t>());
 
+                if (_options->count("shared-file-grow-size"))
+                {
+                    _chain_db->set_shared_memory_growth(
+                        fc::parse_size(_options->at("shared-file-min-free").as<std::string>()),
+                        fc::parse_size(_options->at("shared-file-grow-size").as<std::string>()));
+                }
+
                 flat_map<uint32_t, block_id_type> loaded_checkpoints;
                 if (_options->count("checkpoint"))
                 {
@@ -396,6 +422,11 @@ public:
                     }
                 }
 
+                if (_options->count("compact-shared-file"))
+                {
+                    _chain_db->compact_shared_memory(_shared_file_size);
+                }
+
                 if (_options->count("force-validate"))
                 {
                     ilog("All transaction signatures will be validated");
@@ -1140,6 +1171,12 @@ void application::set_program_options(boost::program_options::options_descriptio
     ("data-dir,d", bpo::value<boost::filesystem::path>()->default_value("witness_node_data_dir"), "Directory containing databases, configuration file, etc.")
     ("shared-file-dir", bpo::value<std::string>(), "Location of the shared memory file. Defaults to data_dir/blockchain")
     ("shared-file-size", bpo::value<std::string>()->default_value("54G"), "Size of the shared memory file. Default: 54G")
+    ("compact-shared-file", "Rewrite the shared memory file into a fresh file of shared-file-size on start, reclaiming the memory fragmented by removed objects")
+    ("shared-file-grow-size", bpo::value<std::string>(), "Grow the shared memory file by this size between blocks when it is almost full, e.g. 8G")
+    ("shared-file-min-free", bpo::value<std::string>()->default_value("2G"), "Free memory of the shared memory file that triggers the growth. Default: 2G")
+    ("shared-file-huge-pages", "Map the shared memory file with transparent huge pages, the kernel supports them for shared-file-dir on tmpfs (e.g. /dev/shm)")
+    ("shared-file-prefault", "Read the whole shared memory file on open, so blocks are not applied over cold page faults after a restart")
+    ("shared-file-access-hint", bpo::value<std::string>()->default_value("normal"), "Access hint for the shared memory file: normal, random, sequential or willneed")
     ("rpc-endpoint", bpo::value<std::string>()->implicit_value("127.0.0.1:8090"), "Endpoint for websocket RPC to listen on")
     ("rpc-tls-endpoint", bpo::value<std::string>()->implicit_value("127.0.0.1:8089"), "Endpoint for TLS websocket RPC to listen on")
     ("read-forward-rpc", bpo::value<std::string>(), "Endpoint to forward write API calls to for a read node")
@@ -1149,7 +1186,7 @@ void application::set_program_options(boost::program_options::options_descriptio
     ("public-api", bpo::value< std::vector<std::string> >()->composing()->default_value(default_apis, str_default_apis), "Set an API to be publicly available, may be specified multiple times")
     ("enable-plugin", bpo::value< std::vector<std::string> >()->composing()->default_value(default_plugins, str_default_plugins), "Plugin(s) to enable, may be specified multiple times")
     ("max-block-age", bpo::value< int32_t >()->default_value(200), "Maximum age of head block when broadcasting tx via API")
-    ("flush", bpo::value< uint32_t >()->default_value(100000), "Flush shared memory file to disk this many blocks")
+    ("flush", bpo::value< uint32_t >()->default_value(100000), "Flush shared memory file to disk in the background this many blocks")
     ("genesis-json,g", bpo::value<boost::filesystem::path>(), "File to read genesis state from")
     ("replay-blockchain", "Rebuild object graph by replaying all blocks")
     ("resync-blockchain", "Delete all blocks and re-sync with network from scratch")
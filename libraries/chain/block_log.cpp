@@ -185,6 +185,11 @@ bool block_log::is_open() const
 }
 
 uint64_t block_log::append(const signed_block& b)
+{
+    return append(b, b.id());
+}
+
+uint64_t block_log::append(const signed_block& b, const block_id_type& block_id)
 {
     try
     {
@@ -202,7 +207,7 @@ uint64_t block_log::append(const signed_block& b)
         my->block_stream.write((char*)&pos, sizeof(pos));
         my->index_stream.write((char*)&pos, sizeof(pos));
         my->head = b;
-        my->head_id = b.id();
+        my->head_id = block_id;
 
         return pos;
     }
@@ -0,0 +1,272 @@
+#include <scorum/chain/database/block_profiler.hpp>
+
+#include <scorum/protocol/operation_util_impl.hpp>
+
+#include <fc/log/logger.hpp>
+#include <fc/variant_object.hpp>
+
+#include <algorithm>
+
+namespace scorum {
+namespace chain {
+
+namespace {
+
+const size_t profiled_phases_count
+    = block_profiler::phases_count + scorum::protocol::operation_table<operation>::count;
+
+const char* phase_names[block_profiler::phases_count] = {
+    "block",
+    "merkle_check",
+    "validate_block_header",
+    "pre_apply_block_signal",
+    "transaction",
+    "pre_apply_transaction_signal",
+    "pre_apply_operation_signal",
+    "post_apply_operation_signal",
+    "update_witness_schedule",
+    "process_funds",
+    "process_comments_cashout",
+    "process_vesting_withdrawals",
+    "clear_expired_transactions",
+    "clear_expired_delegations",
+    "applied_block_signal",
+};
+}
+
+const size_t block_profiler::histogram_buckets;
+const uint32_t block_profiler::default_window_blocks;
+
+void block_profiler::histogram::add(int64_t us)
+{
+    ++count;
+    total_us += us;
+    max_us = std::max(max_us, us);
+
+    size_t bucket = 0;
+    while (bucket + 1 < histogram_buckets && us >= (int64_t(1) << bucket))
+        ++bucket;
+
+    ++buckets[bucket];
+}
+
+void block_profiler::histogram::merge(const histogram& other)
+{
+    count += other.count;
+    total_us += other.total_us;
+    max_us = std::max(max_us, other.max_us);
+
+    for (size_t i = 0; i < histogram_buckets; ++i)
+        buckets[i] += other.buckets[i];
+}
+
+block_profiler::block_profiler()
+    : _current(profiled_phases_count)
+    , _previous(profiled_phases_count)
+    , _block(profiled_phases_count)
+    , _last_block(profiled_phases_count)
+{
+}
+
+std::string block_profiler::phase_name(uint16_t phase)
+{
+    if (phase < phases_count)
+        return phase_names[phase];
+
+    const auto& metadata = scorum::protocol::operation_table<operation>::metadata();
+    FC_ASSERT(phase < profiled_phases_count, "Unknown block phase ${p}", ("p", phase));
+
+    return "evaluator:" + fc::name_from_type(metadata[phase - phases_count].name);
+}
+
+void block_profiler::begin_block(uint32_t block_num)
+{
+    std::fill(_block.begin(), _block.end(), block_sample());
+
+    _block_num = block_num;
+    _block_start = fc::time_point::now();
+    _in_block = true;
+}
+
+void block_profiler::end_block()
+{
+    if (!_in_block)
+        return;
+
+    add(block, fc::time_point::now() - _block_start);
+    _in_block = false;
+
+    _last_block.swap(_block);
+    _last_block_num = _block_num;
+
+    if (_current_blocks == 0)
+        _current_first_block = _block_num;
+
+    if (++_current_blocks >= _window_blocks)
+    {
+        _previous.swap(_current);
+        std::fill(_current.begin(), _current.end(), histogram());
+        _previous_first_block = _current_first_block;
+        _current_blocks = 0;
+
+        std::lock_guard<std::mutex> lock(_handlers_mutex);
+        _handlers_previous.swap(_handlers_current);
+        std::fill(_handlers_current.begin(), _handlers_current.end(), histogram());
+    }
+
+    if (_dump && _last_block[block].total_us >= _dump_threshold.count())
+        dump();
+}
+
+void block_profiler::cancel_block()
+{
+    _in_block = false;
+}
+
+void block_profiler::add(uint16_t phase, const fc::microseconds& elapsed)
+{
+    if (!_in_block)
+        return;
+
+    const int64_t us = elapsed.count();
+
+    _current[phase].add(us);
+
+    ++_block[phase].count;
+    _block[phase].total_us += us;
+}
+
+uint16_t block_profiler::add_handler(const std::string& plugin, uint16_t signal, bool async)
+{
+    std::lock_guard<std::mutex> lock(_handlers_mutex);
+
+    _handlers.push_back({ plugin, signal, async });
+    _handlers_current.emplace_back();
+    _handlers_previous.emplace_back();
+
+    return _handlers.size() - 1;
+}
+
+void block_profiler::add_handler_sample(uint16_t handler, const fc::microseconds& elapsed)
+{
+    std::lock_guard<std::mutex> lock(_handlers_mutex);
+
+    if (!_handlers[handler].async && !_in_block)
+        return;
+
+    _handlers_current[handler].add(elapsed.count());
+}
+
+void block_profiler::set_window(uint32_t window_blocks)
+{
+    FC_ASSERT(window_blocks > 0, "Profiler window should not be empty.");
+    _window_blocks = window_blocks;
+}
+
+void block_profiler::set_dump_threshold(const fc::microseconds& threshold)
+{
+    _dump = true;
+    _dump_threshold = threshold;
+}
+
+void block_profiler::disable_dump()
+{
+    _dump = false;
+}
+
+block_profile block_profiler::get_profile() const
+{
+    block_profile result;
+    result.first_block = _previous_first_block ? _previous_first_block : _current_first_block;
+    result.last_block = _last_block_num;
+
+    for (size_t phase = 0; phase < profiled_phases_count; ++phase)
+    {
+        histogram merged = _previous[phase];
+        merged.merge(_current[phase]);
+
+        if (merged.count == 0)
+            continue;
+
+        block_phase_stats stats;
+        stats.phase = phase_name(phase);
+        stats.count = merged.count;
+        stats.total_us = merged.total_us;
+        stats.max_us = merged.max_us;
+        stats.histogram.assign(merged.buckets.begin(), merged.buckets.end());
+
+        result.phases.push_back(std::move(stats));
+    }
+
+    std::lock_guard<std::mutex> lock(_handlers_mutex);
+
+    for (size_t handler = 0; handler < _handlers.size(); ++handler)
+    {
+        histogram merged = _handlers_previous[handler];
+        merged.merge(_handlers_current[handler]);
+
+        plugin_handler_stats stats;
+        stats.plugin = _handlers[handler].plugin;
+        stats.signal = phase_name(_handlers[handler].signal);
+        stats.async = _handlers[handler].async;
+        stats.count = merged.count;
+        stats.total_us = merged.total_us;
+        stats.max_us = merged.max_us;
+        stats.histogram.assign(merged.buckets.begin(), merged.buckets.end());
+
+        result.handlers.push_back(std::move(stats));
+    }
+
+    return result;
+}
+
+block_profile block_profiler::get_last_block_profile() const
+{
+    block_profile result;
+    result.first_block = _last_block_num;
+    result.last_block = _last_block_num;
+
+    for (size_t phase = 0; phase < profiled_phases_count; ++phase)
+    {
+        const block_sample& sample = _last_block[phase];
+        if (sample.count == 0)
+            continue;
+
+        block_phase_stats stats;
+        stats.phase = phase_name(phase);
+        stats.count = sample.count;
+        stats.total_us = sample.total_us;
+
+        result.phases.push_back(std::move(stats));
+    }
+
+    return result;
+}
+
+void block_profiler::reset()
+{
+    std::fill(_current.begin(), _current.end(), histogram());
+    std::fill(_previous.begin(), _previous.end(), histogram());
+    _current_first_block = 0;
+    _previous_first_block = 0;
+    _current_blocks = 0;
+
+    std::lock_guard<std::mutex> lock(_handlers_mutex);
+    std::fill(_handlers_current.begin(), _handlers_current.end(), histogram());
+    std::fill(_handlers_previous.begin(), _handlers_previous.end(), histogram());
+}
+
+void block_profiler::dump() const
+{
+    fc::mutable_variant_object phases;
+    for (size_t phase = 0; phase < profiled_phases_count; ++phase)
+    {
+        const block_sample& sample = _last_block[phase];
+        if (sample.count != 0 && phase != block)
+            phases(phase_name(phase), fc::mutable_variant_object("count", sample.count)("us", sample.total_us));
+    }
+
+    ilog("Block ${n} applied in ${t} us: ${p}", ("n", _last_block_num)("t", _last_block[block].total_us)("p", phases));
+}
+}
+}
@@ -51,6 +51,7 @@ void process_comments_cashout::on_apply(block_task_context& ctx)
     const auto& rf = reward_fund_service.get();
 
     asset scorum_awarded = asset(0, SCORUM_SYMBOL);
+    curation_rewards_type curation_rewards;
     for (const comment_object& comment : comments)
     {
         if (comment.cashout_time > dgp_service.head_block_time())
@@ -66,7 +67,7 @@ void process_comments_cashout::on_apply(block_task_context& ctx)
             comr_ctx.reward_weight = comment.reward_weight;
             comr_ctx.max_scr = comment.max_accepted_payout;
 
-            scorum_awarded += pay_for_comment(ctx, comment, util::get_rshare_reward(comr_ctx));
+            scorum_awarded += pay_for_comment(ctx, comment, util::get_rshare_reward(comr_ctx), curation_rewards);
         }
 
         comment_service.update(comment, [&](comment_object& c) {
@@ -98,6 +99,8 @@ void process_comments_cashout::on_apply(block_task_context& ctx)
 #endif
     }
 
+    pay_curation_rewards(ctx, curation_rewards);
+
     // Write the cached fund state back to the database
     reward_fund_service.update([&](reward_fund_object& rfo) {
         rfo.recent_claims = recent_claims;
@@ -132,7 +135,8 @@ uint128_t process_comments_cashout::get_recent_claims(block_task_context& ctx,
 
 asset process_comments_cashout::pay_for_comment(block_task_context& ctx,
                                                 const comment_object& comment,
-                                                const asset& reward)
+                                                const asset& reward,
+                                                curation_rewards_type& curation_rewards)
 {
     data_service_factory_i& services = ctx.services();
     account_service_i& account_service = services.account_service();
@@ -146,7 +150,7 @@ asset process_comments_cashout::pay_for_comment(block_task_context& ctx,
             asset curation_tokens = asset((uint128_t(reward.amount.value) * SCORUM_CURATION_REWARD_PERCENT / SCORUM_100_PERCENT).to_uint64(), reward.symbol());
             asset author_tokens = reward - curation_tokens;
 
-            author_tokens += pay_curators(ctx, comment, curation_tokens); // curation_tokens can be changed inside pay_curators()
+            author_tokens += pay_curators(ctx, comment, curation_tokens, curation_rewards); // curation_tokens can be changed inside pay_curators()
 
             asset claimed_reward = author_tokens + curation_tokens;
 
@@ -190,8 +194,10 @@ asset process_comments_cashout::pay_for_comment(block_task_context& ctx,
     FC_CAPTURE_AND_RETHROW((comment))
 }
 
-asset
-process_comments_cashout::pay_curators(block_task_context& ctx, const comment_object& comment, asset& max_rewards)
+asset process_comments_cashout::pay_curators(block_task_context& ctx,
+                                             const comment_object& comment,
+                                             asset& max_rewards,
+                                             curation_rewards_type& curation_rewards)
 {
     data_service_factory_i& services = ctx.services();
     account_service_i& account_service = services.account_service();
@@ -221,14 +227,17 @@ process_comments_cashout::pay_curators(block_task_context& ctx, const comment_ob
                 {
                     unclaimed_rewards -= claim;
                     const auto& voter = account_service.get(vote.voter);
-                    auto reward = account_service.create_scorumpower(voter, claim);
 
+                    // the reward is paid by pay_curation_rewards, the scorumpower created for it is the same amount
+                    auto it = curation_rewards.find(vote.voter);
+                    if (it == curation_rewards.end())
+                        curation_rewards.insert(std::make_pair(vote.voter, claim));
+                    else
+                        it->second += claim;
+
+                    auto reward = asset(claim.amount, SP_SYMBOL);
                     ctx.push_virtual_operation(
                         curation_reward_operation(voter.name, reward, comment.author, fc::to_string(comment.permlink)));
-
-#ifndef IS_LOW_MEM
-                    account_service.increase_curation_rewards(voter, claim);
-#endif
                 }
             }
         }
@@ -238,6 +247,22 @@ process_comments_cashout::pay_curators(block_task_context& ctx, const comment_ob
     }
     FC_CAPTURE_AND_RETHROW()
 }
+
+void process_comments_cashout::pay_curation_rewards(block_task_context& ctx,
+                                                    const curation_rewards_type& curation_rewards)
+{
+    account_service_i& account_service = ctx.services().account_service();
+
+    for (const auto& item : curation_rewards)
+    {
+        const auto& voter = account_service.get(item.first);
+        account_service.create_scorumpower(voter, item.second);
+
+#ifndef IS_LOW_MEM
+        account_service.increase_curation_rewards(voter, item.second);
+#endif
+    }
+}
 }
 }
 }
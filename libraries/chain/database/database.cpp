@@ -92,6 +92,56 @@ database_impl::database_impl(database& self)
 {
 }
 
+namespace {
+/// witness vote changes of the block being applied are batched, the batch is dropped if the block fails
+class witness_votes_batch
+{
+public:
+    explicit witness_votes_batch(dbs_witness& witness_service)
+        : _witness_service(witness_service)
+    {
+        _witness_service.begin_votes_batch();
+    }
+
+    ~witness_votes_batch()
+    {
+        _witness_service.end_votes_batch();
+    }
+
+    void flush()
+    {
+        _witness_service.flush_votes_batch();
+    }
+
+private:
+    dbs_witness& _witness_service;
+};
+
+/// profiles the block being applied, the block is dropped from the profile if it fails
+class block_profile_scope
+{
+public:
+    block_profile_scope(block_profiler& profiler, uint32_t block_num)
+        : _profiler(profiler)
+    {
+        _profiler.begin_block(block_num);
+    }
+
+    ~block_profile_scope()
+    {
+        _profiler.cancel_block();
+    }
+
+    void end()
+    {
+        _profiler.end_block();
+    }
+
+private:
+    block_profiler& _profiler;
+};
+}
+
 database::database()
     : chainbase::database()
     , dbservice_dbs_factory(*this)
@@ -115,6 +165,18 @@ void database::open(const fc::path& data_dir,
     {
         chainbase::database::open(shared_mem_dir, chainbase_flags, shared_file_size);
 
+        const auto& checkpoint = get_opened_checkpoint();
+        if ((chainbase_flags & chainbase::database::read_write) && checkpoint && !checkpoint->clean)
+        {
+            wlog("Shared memory file was not closed cleanly, it was last flushed at block ${b}. Replay the blockchain "
+                 "if the host was restarted since then.",
+                 ("b", checkpoint->head));
+        }
+
+        // objects cached by the services are from the previous mapping of the shared memory
+        clear_services_cache();
+        bind_services();
+
         // must be initialized before evaluators creation
         _my->_genesis_persistent_state = static_cast<const genesis_persistent_state_type&>(genesis_state);
 
@@ -158,6 +220,9 @@ void database::open(const fc::path& data_dir,
             }
         }
 
+        // API threads read the cached objects, so they are never looked up lazily
+        with_write_lock([&]() { reset_services_cache(); });
+
         try
         {
             const auto& chain_id = get<chain_property_object>().chain_id;
@@ -210,6 +275,7 @@ void database::reindex(const fc::path& data_dir,
                               << " of " << last_block_num << "   (" << (get_free_memory() / (1024 * 1024))
                               << "M free)\n";
                 apply_block(itr.first, skip_flags);
+                maybe_grow_shared_memory();
                 itr = _block_log.read_block(itr.second);
             }
 
@@ -249,14 +315,17 @@ void database::close()
         // DB state (issue #336).
         clear_pending();
 
+        _async_notifications.stop();
+
         try
         {
-            chainbase::database::flush();
+            chainbase::database::checkpoint(head_block_num());
         }
         catch (...)
         {
         }
 
+        clear_services_cache();
         chainbase::database::close();
 
         _block_log.close();
@@ -388,12 +457,34 @@ const signed_transaction database::get_recent_transaction(const transaction_id_t
         auto& index = get_index<transaction_index>().indices().get<by_trx_id>();
         auto itr = index.find(trx_id);
         FC_ASSERT(itr != index.end());
-        signed_transaction trx;
-        fc::raw::unpack(itr->packed_trx, trx);
-        return trx;
-        ;
+
+        for (const signed_transaction& trx : _pending_tx)
+        {
+            if (trx.id() == trx_id)
+                return trx;
+        }
+
+        optional<signed_block> block;
+
+        // the transaction is known to the current state, so its block is on the main branch
+        std::shared_ptr<fork_item> fitem = _fork_db.fetch_block_on_main_branch_by_number(itr->block_num);
+        if (fitem)
+            block = fitem->data;
+        else
+            block = _block_log.read_block_by_num(itr->block_num);
+
+        if (block.valid())
+        {
+            for (const signed_transaction& trx : block->transactions)
+            {
+                if (trx.id() == trx_id)
+                    return trx;
+            }
+        }
+
+        FC_THROW("Transaction is not found in block ${b}", ("b", itr->block_num));
     }
-    FC_CAPTURE_AND_RETHROW()
+    FC_CAPTURE_AND_RETHROW((trx_id))
 }
 
 std::vector<block_id_type> database::get_block_ids_on_fork(block_id_type head_of_fork) const
@@ -469,6 +560,10 @@ bool database::push_block(const signed_block& new_block, uint32_t skip)
                 try
                 {
                     result = _push_block(new_block);
+
+                    // the pending transactions are cleared and the block session is pushed, no undo session is
+                    // active until the pending transactions are restored
+                    maybe_grow_shared_memory();
                 }
                 FC_CAPTURE_AND_RETHROW((new_block))
             });
@@ -519,7 +614,7 @@ bool database::_push_block(const signed_block& new_block)
                 if (new_head->data.block_num() > head_block_num())
                 {
                     // wlog( "Switching to fork: ${id}", ("id",new_head->data.id()) );
-                    auto branches = _fork_db.fetch_branch_from(new_head->data.id(), head_block_id());
+                    auto branches = _fork_db.fetch_branch_from(new_head->id, head_block_id());
 
                     // pop blocks until we hit the forked block
                     while (head_block_id() != branches.second.back()->data.previous)
@@ -536,7 +631,7 @@ bool database::_push_block(const signed_block& new_block)
                         try
                         {
                             auto session = start_undo_session();
-                            apply_block((*ritr)->data, skip);
+                            apply_block((*ritr)->data, (*ritr)->id, skip);
                             session->push();
                         }
                         catch (const fc::exception& e)
@@ -549,7 +644,7 @@ bool database::_push_block(const signed_block& new_block)
                             // remove the rest of branches.first from the fork_db, those blocks are invalid
                             while (ritr != branches.first.rend())
                             {
-                                _fork_db.remove((*ritr)->data.id());
+                                _fork_db.remove((*ritr)->id);
                                 ++ritr;
                             }
                             _fork_db.set_head(branches.second.front());
@@ -564,7 +659,7 @@ bool database::_push_block(const signed_block& new_block)
                             for (auto ritr = branches.second.rbegin(); ritr != branches.second.rend(); ++ritr)
                             {
                                 auto session = start_undo_session();
-                                apply_block((*ritr)->data, skip);
+                                apply_block((*ritr)->data, (*ritr)->id, skip);
                                 session->push();
                             }
                             throw * except;
@@ -579,16 +674,18 @@ bool database::_push_block(const signed_block& new_block)
             }
         }
 
+        const block_id_type new_block_id = new_block.id();
+
         try
         {
             auto session = start_undo_session();
-            apply_block(new_block, skip);
+            apply_block(new_block, new_block_id, skip);
             session->push();
         }
         catch (const fc::exception& e)
         {
             elog("Failed to push new block:\n${e}", ("e", e.to_detail_string()));
-            _fork_db.remove(new_block.id());
+            _fork_db.remove(new_block_id);
             throw;
         }
 
@@ -719,6 +816,7 @@ signed_block database::_generate_block(fc::time_point_sec when,
         // re-apply pending transactions in this method.
         //
         _pending_tx_session.reset();
+        notify_on_clear_pending();
         _pending_tx_session = start_undo_session();
 
         uint64_t postponed_tx_count = 0;
@@ -832,6 +930,7 @@ void database::pop_block()
     try
     {
         _pending_tx_session.reset();
+        notify_on_clear_pending();
         auto head_id = head_block_id();
 
         /// save the head block so we can recover its transactions
@@ -854,6 +953,7 @@ void database::clear_pending()
         assert((_pending_tx.size() == 0) || _pending_tx_session.valid());
         _pending_tx.clear();
         _pending_tx_session.reset();
+        notify_on_clear_pending();
     }
     FC_CAPTURE_AND_RETHROW()
 }
@@ -865,11 +965,13 @@ void database::notify_pre_apply_operation(operation_notification& note)
     note.trx_in_block = _current_trx_in_block;
     note.op_in_trx = _current_op_in_trx;
 
+    block_profiler::scope profile(_block_profiler, block_profiler::pre_apply_operation_signal);
     SCORUM_TRY_NOTIFY(pre_apply_operation, note)
 }
 
 void database::notify_post_apply_operation(const operation_notification& note)
 {
+    block_profiler::scope profile(_block_profiler, block_profiler::post_apply_operation_signal);
     SCORUM_TRY_NOTIFY(post_apply_operation, note)
 }
 
@@ -893,8 +995,15 @@ inline void database::push_hf_operation(const operation& op)
     notify_post_apply_operation(note);
 }
 
+void database::notify_pre_apply_block(const signed_block& block)
+{
+    block_profiler::scope profile(_block_profiler, block_profiler::pre_apply_block_signal);
+    SCORUM_TRY_NOTIFY(pre_apply_block, block)
+}
+
 void database::notify_applied_block(const signed_block& block)
 {
+    block_profiler::scope profile(_block_profiler, block_profiler::applied_block_signal);
     SCORUM_TRY_NOTIFY(applied_block, block)
 }
 
@@ -905,6 +1014,7 @@ void database::notify_on_pending_transaction(const signed_transaction& tx)
 
 void database::notify_on_pre_apply_transaction(const signed_transaction& tx)
 {
+    block_profiler::scope profile(_block_profiler, block_profiler::pre_apply_transaction_signal);
     SCORUM_TRY_NOTIFY(on_pre_apply_transaction, tx)
 }
 
@@ -913,6 +1023,11 @@ void database::notify_on_applied_transaction(const signed_transaction& tx)
     SCORUM_TRY_NOTIFY(on_applied_transaction, tx);
 }
 
+void database::notify_on_clear_pending()
+{
+    SCORUM_TRY_NOTIFY(on_clear_pending);
+}
+
 account_name_type database::get_scheduled_witness(uint32_t slot_num) const
 {
     const dynamic_global_property_object& dpo = obtain_service<dbs_dynamic_global_property>().get();
@@ -1166,18 +1281,23 @@ void database::set_flush_interval(uint32_t flush_blocks)
 //////////////////// private methods ////////////////////
 
 void database::apply_block(const signed_block& next_block, uint32_t skip)
+{
+    apply_block(next_block, next_block.id(), skip);
+}
+
+void database::apply_block(const signed_block& next_block, const block_id_type& next_block_id, uint32_t skip)
 {
     try
     {
-        // fc::time_point begin_time = fc::time_point::now();
-
         auto block_num = next_block.block_num();
+
+        block_profile_scope profile(_block_profiler, block_num);
         if (_checkpoints.size() && _checkpoints.rbegin()->second != block_id_type())
         {
             auto itr = _checkpoints.find(block_num);
             if (itr != _checkpoints.end())
-                FC_ASSERT(next_block.id() == itr->second, "Block did not match checkpoint",
-                          ("checkpoint", *itr)("block_id", next_block.id()));
+                FC_ASSERT(next_block_id == itr->second, "Block did not match checkpoint",
+                          ("checkpoint", *itr)("block_id", next_block_id));
 
             if (_checkpoints.rbegin()->first >= block_num)
                 skip = skip_witness_signature | skip_transaction_signatures | skip_transaction_dupe_check | skip_fork_db
@@ -1187,7 +1307,17 @@ void database::apply_block(const signed_block& next_block, uint32_t skip)
                     | skip_undo_history_check | skip_witness_schedule_check | skip_validate | skip_validate_invariants;
         }
 
-        detail::with_skip_flags(*this, skip, [&]() { _apply_block(next_block); });
+        _async_notifications.begin_block();
+        try
+        {
+            detail::with_skip_flags(*this, skip, [&]() { _apply_block(next_block, next_block_id); });
+        }
+        catch (...)
+        {
+            _async_notifications.discard_block();
+            throw;
+        }
+        _async_notifications.commit_block();
 
         /// check invariants
         if (is_producing() || !(skip & skip_validate_invariants))
@@ -1203,8 +1333,6 @@ void database::apply_block(const signed_block& next_block, uint32_t skip)
 #endif
         }
 
-        // fc::time_point end_time = fc::time_point::now();
-        // fc::microseconds dt = end_time - begin_time;
         if (_flush_blocks != 0)
         {
             if (_next_flush_block == 0)
@@ -1228,15 +1356,91 @@ void database::apply_block(const signed_block& next_block, uint32_t skip)
             {
                 _next_flush_block = 0;
                 // ilog( "Flushing database shared memory at block ${b}", ("b", block_num) );
-                chainbase::database::flush();
+                if (!chainbase::database::flush_in_background(block_num))
+                    wlog("Shared memory flush at block ${b} is skipped, the previous flush is still running",
+                         ("b", block_num));
             }
         }
 
+        profile.end();
+
         show_free_memory(false);
     }
     FC_CAPTURE_AND_RETHROW((next_block))
 }
 
+void database::set_shared_memory_growth(uint64_t min_free, uint64_t grow_size)
+{
+    _shared_memory_min_free = min_free;
+    _shared_memory_grow_size = grow_size;
+}
+
+void database::maybe_grow_shared_memory()
+{
+    if (_shared_memory_grow_size == 0 || get_free_memory() >= _shared_memory_min_free)
+        return;
+
+    const fc::time_point start = fc::time_point::now();
+
+    try
+    {
+        // readers left on older locks by write lock timeouts would read the unmapped file
+        with_all_locks([&]() {
+            try
+            {
+                chainbase::database::grow(_shared_memory_grow_size);
+            }
+            catch (...)
+            {
+                // the file is mapped again even if it is not grown, singleton objects cached by the services are moved
+                reset_services_cache();
+                throw;
+            }
+            reset_services_cache();
+        });
+
+        ilog("Shared memory file is grown by ${g}M in ${t} ms, free memory is now ${f}M",
+             ("g", _shared_memory_grow_size / (1024 * 1024))("t", (fc::time_point::now() - start).count() / 1000)(
+                 "f", get_free_memory() / (1024 * 1024)));
+    }
+    catch (const fc::exception& e)
+    {
+        elog("Could not grow shared memory file: ${e}. Growth is disabled, increase shared file size immediately!",
+             ("e", e.to_detail_string()));
+        _shared_memory_grow_size = 0;
+    }
+    catch (const std::exception& e)
+    {
+        elog("Could not grow shared memory file: ${e}. Growth is disabled, increase shared file size immediately!",
+             ("e", e.what()));
+        _shared_memory_grow_size = 0;
+    }
+}
+
+void database::compact_shared_memory(uint64_t shared_file_size)
+{
+    const fc::time_point start = fc::time_point::now();
+    chainbase::segment_free_blocks fragmented;
+
+    with_write_lock(
+        [&]() {
+            // the free blocks are taken from the allocator while they are counted, nothing else runs on start
+            fragmented = get_segment_free_blocks();
+
+            chainbase::database::compact(shared_file_size);
+
+            // the indexes are in another file now, singleton objects cached by the services are moved
+            reset_services_cache();
+        },
+        0);
+
+    ilog("Shared memory file is compacted to ${s}M in ${t} ms, free memory is ${f}M (was ${w}M in ${b} blocks, the "
+         "largest one ${l}M)",
+         ("s", shared_file_size / (1024 * 1024))("t", (fc::time_point::now() - start).count() / 1000)(
+             "f", get_free_memory() / (1024 * 1024))("w", fragmented.free / (1024 * 1024))("b", fragmented.blocks)(
+             "l", fragmented.largest / (1024 * 1024)));
+}
+
 void database::show_free_memory(bool force)
 {
 #ifdef IS_TEST_NET
@@ -1249,6 +1453,13 @@ void database::show_free_memory(bool force)
         _last_free_gb_printed = free_gb;
     }
 
+    if (force)
+    {
+        const chainbase::segment_stats stats = get_segment_stats();
+        ilog("Shared memory file is ${r}M resident of ${s}M, ${f} major page faults so far",
+             ("r", stats.resident / (1024 * 1024))("s", stats.size / (1024 * 1024))("f", stats.major_faults));
+    }
+
     if (free_gb == 0)
     {
         uint32_t free_mb = uint32_t(get_free_memory() / (1024 * 1024));
@@ -1261,24 +1472,25 @@ void database::show_free_memory(bool force)
 #endif
 }
 
-void database::_apply_block(const signed_block& next_block)
+void database::_apply_block(const signed_block& next_block, const block_id_type& next_block_id)
 {
     try
     {
         uint32_t next_block_num = next_block.block_num();
-        // block_id_type next_block_id = next_block.id();
 
         uint32_t skip = get_node_properties().skip_flags;
 
         if (!(skip & skip_merkle_check))
         {
+            block_profiler::scope profile(_block_profiler, block_profiler::merkle_check);
+
             auto merkle_root = next_block.calculate_merkle_root();
 
             try
             {
                 FC_ASSERT(next_block.transaction_merkle_root == merkle_root, "Merkle check failed",
                           ("next_block.transaction_merkle_root", next_block.transaction_merkle_root)(
-                              "calc", merkle_root)("next_block", next_block)("id", next_block.id()));
+                              "calc", merkle_root)("next_block", next_block)("id", next_block_id));
             }
             catch (fc::assert_exception& e)
             {
@@ -1292,11 +1504,17 @@ void database::_apply_block(const signed_block& next_block)
             }
         }
 
-        const witness_object& signing_witness = validate_block_header(skip, next_block);
+        const witness_object* signing_witness = nullptr;
+        {
+            block_profiler::scope profile(_block_profiler, block_profiler::validate_block_header);
+            signing_witness = &validate_block_header(skip, next_block);
+        }
 
         _current_block_num = next_block_num;
         _current_trx_in_block = 0;
 
+        notify_pre_apply_block(next_block);
+
         const auto& gprops = obtain_service<dbs_dynamic_global_property>().get();
         auto block_size = fc::raw::pack_size(next_block);
         FC_ASSERT(block_size <= gprops.median_chain_props.maximum_block_size, "Block Size is too Big",
@@ -1312,6 +1530,8 @@ void database::_apply_block(const signed_block& next_block)
 
         const auto& witness = obtain_service<dbs_witness>().get(next_block.witness);
         const auto& hardfork_state = obtain_service<dbs_hardfork_property>().get();
+
+        witness_votes_batch votes_batch(obtain_service<dbs_witness>());
         FC_ASSERT(witness.running_version >= hardfork_state.current_hardfork_version,
                   "Block produced by witness that is not running current hardfork",
                   ("witness", witness)("next_block.witness", next_block.witness)("hardfork_state", hardfork_state));
@@ -1324,19 +1544,23 @@ void database::_apply_block(const signed_block& next_block)
              * for transactions when validating broadcast transactions or
              * when building a block.
              */
+            block_profiler::scope profile(_block_profiler, block_profiler::transaction);
             apply_transaction(trx, skip);
             ++_current_trx_in_block;
         }
 
-        update_global_dynamic_data(next_block);
-        update_signing_witness(signing_witness, next_block);
+        update_global_dynamic_data(next_block, next_block_id);
+        update_signing_witness(*signing_witness, next_block);
 
         update_last_irreversible_block();
 
-        create_block_summary(next_block);
+        create_block_summary(next_block, next_block_id);
         clear_expired_transactions();
         clear_expired_delegations();
 
+        // the schedule reads the votes changed by the transactions of the block
+        votes_batch.flush();
+
         // in dbs_database_witness_schedule.cpp
         update_witness_schedule();
 
@@ -1344,7 +1568,18 @@ void database::_apply_block(const signed_block& next_block)
                                             static_cast<database_virtual_operations_emmiter_i&>(*this),
                                             _current_block_num);
 
-        _my->_process_funds.before(_my->_process_comments_cashout).before(_my->_process_vesting_withdrawals).apply(ctx);
+        {
+            block_profiler::scope profile(_block_profiler, block_profiler::process_funds);
+            _my->_process_funds.apply(ctx);
+        }
+        {
+            block_profiler::scope profile(_block_profiler, block_profiler::process_comments_cashout);
+            _my->_process_comments_cashout.apply(ctx);
+        }
+        {
+            block_profiler::scope profile(_block_profiler, block_profiler::process_vesting_withdrawals);
+            _my->_process_vesting_withdrawals.apply(ctx);
+        }
 
         obtain_service<dbs_atomicswap>().check_contracts_expiration();
 
@@ -1356,6 +1591,8 @@ void database::_apply_block(const signed_block& next_block)
 
         process_hardforks();
 
+        votes_batch.flush();
+
         // notify observers that the block has been applied
         notify_applied_block(next_block);
     }
@@ -1419,7 +1656,8 @@ void database::_apply_transaction(const signed_transaction& trx)
 {
     try
     {
-        _current_trx_id = trx.id();
+        const transaction_id_type trx_id = trx.id();
+        _current_trx_id = trx_id;
         uint32_t skip = get_node_properties().skip_flags;
 
         if (!(skip & skip_validate)) /* issue #505 explains why this skip_flag is disabled */
@@ -1428,7 +1666,6 @@ void database::_apply_transaction(const signed_transaction& trx)
         }
 
         auto& trx_idx = get_index<transaction_index>();
-        auto trx_id = trx.id();
         // idump((trx_id)(skip&skip_transaction_dupe_check));
         FC_ASSERT((skip & skip_transaction_dupe_check)
                       || trx_idx.indices().get<by_trx_id>().find(trx_id) == trx_idx.indices().get<by_trx_id>().end(),
@@ -1436,14 +1673,16 @@ void database::_apply_transaction(const signed_transaction& trx)
 
         if (!(skip & (skip_transaction_signatures | skip_authority_check)))
         {
-            auto get_active = [&](const std::string& name) {
-                return authority(get<account_authority_object, by_account>(name).active);
+            const auto& account_service = obtain_service<dbs_account>();
+
+            auto get_active = [&](const account_name_type& name) {
+                return account_service.get_authority(name, authority::active);
             };
-            auto get_owner = [&](const std::string& name) {
-                return authority(get<account_authority_object, by_account>(name).owner);
+            auto get_owner = [&](const account_name_type& name) {
+                return account_service.get_authority(name, authority::owner);
             };
-            auto get_posting = [&](const std::string& name) {
-                return authority(get<account_authority_object, by_account>(name).posting);
+            auto get_posting = [&](const account_name_type& name) {
+                return account_service.get_authority(name, authority::posting);
             };
 
             try
@@ -1490,7 +1729,8 @@ void database::_apply_transaction(const signed_transaction& trx)
             create<transaction_object>([&](transaction_object& transaction) {
                 transaction.trx_id = trx_id;
                 transaction.expiration = trx.expiration;
-                fc::raw::pack(transaction.packed_trx, trx);
+                // transactions are applied before the head block is updated
+                transaction.block_num = head_block_num() + 1;
             });
         }
 
@@ -1516,7 +1756,10 @@ void database::apply_operation(const operation& op)
 {
     operation_notification note(op);
     notify_pre_apply_operation(note);
-    _my->_evaluator_registry.get_evaluator(op).apply(op);
+    {
+        block_profiler::scope profile(_block_profiler, block_profiler::evaluator_phase(op));
+        _my->_evaluator_registry.get_evaluator(op).apply(op);
+    }
     notify_post_apply_operation(note);
 }
 
@@ -1553,17 +1796,17 @@ const witness_object& database::validate_block_header(uint32_t skip, const signe
     FC_CAPTURE_AND_RETHROW()
 }
 
-void database::create_block_summary(const signed_block& next_block)
+void database::create_block_summary(const signed_block& next_block, const block_id_type& next_block_id)
 {
     try
     {
         block_summary_id_type sid(next_block.block_num() & SCORUM_BLOCKID_POOL_SIZE);
-        modify(get<block_summary_object>(sid), [&](block_summary_object& p) { p.block_id = next_block.id(); });
+        modify(get<block_summary_object>(sid), [&](block_summary_object& p) { p.block_id = next_block_id; });
     }
     FC_CAPTURE_AND_RETHROW()
 }
 
-void database::update_global_dynamic_data(const signed_block& b)
+void database::update_global_dynamic_data(const signed_block& b, const block_id_type& block_id)
 {
     try
     {
@@ -1605,7 +1848,7 @@ void database::update_global_dynamic_data(const signed_block& b)
             }
 
             dgp.head_block_number = b.block_num();
-            dgp.head_block_id = b.id();
+            dgp.head_block_id = block_id;
             dgp.time = b.timestamp;
             dgp.current_aslot += missed_blocks + 1;
         });
@@ -1708,7 +1951,7 @@ void database::update_last_irreversible_block()
                 {
                     std::shared_ptr<fork_item> block = _fork_db.fetch_block_on_main_branch_by_number(log_head_num + 1);
                     FC_ASSERT(block, "Current fork in the fork database does not contain the last_irreversible_block");
-                    _block_log.append(block->data);
+                    _block_log.append(block->data, block->id);
                     log_head_num++;
                 }
 
@@ -1723,6 +1966,8 @@ void database::update_last_irreversible_block()
 
 void database::clear_expired_transactions()
 {
+    block_profiler::scope profile(_block_profiler, block_profiler::clear_expired_transactions);
+
     // Look for expired transactions in the deduplication list, and remove them.
     // Transactions must have expired by at least two forking windows in order to be removed.
     auto& transaction_idx = get_index<transaction_index>();
@@ -1735,6 +1980,8 @@ void database::clear_expired_transactions()
 
 void database::clear_expired_delegations()
 {
+    block_profiler::scope profile(_block_profiler, block_profiler::clear_expired_delegations);
+
     auto now = head_block_time();
     const auto& delegations_by_exp = get_index<scorumpower_delegation_expiration_index, by_expiration>();
     const auto& account_service = obtain_service<dbs_account>();
@@ -0,0 +1,112 @@
+#include <scorum/chain/database/database.hpp>
+
+namespace scorum {
+namespace chain {
+
+namespace {
+
+/// copy of the notification that outlives the emitted one
+std::function<void()> copy_notification(const std::function<void(const operation_notification&)>& handler,
+                                        const operation_notification& note)
+{
+    const std::shared_ptr<operation> op = std::make_shared<operation>(note.op);
+    const transaction_id_type trx_id = note.trx_id;
+    const uint32_t block = note.block;
+    const uint32_t trx_in_block = note.trx_in_block;
+    const uint16_t op_in_trx = note.op_in_trx;
+
+    return [=]() {
+        operation_notification copy(*op);
+        copy.trx_id = trx_id;
+        copy.block = block;
+        copy.trx_in_block = trx_in_block;
+        copy.op_in_trx = op_in_trx;
+
+        handler(copy);
+    };
+}
+
+template <typename Notification>
+std::function<void()> copy_notification(const std::function<void(const Notification&)>& handler,
+                                        const Notification& notification)
+{
+    return [=]() { handler(notification); };
+}
+
+template <typename Notification>
+boost::signals2::connection connect_handler(fc::signal<void(const Notification&)>& signal,
+                                            const std::function<void(const Notification&)>& handler,
+                                            block_profiler& profiler,
+                                            uint16_t handler_id,
+                                            notification_queue& async_notifications,
+                                            bool async)
+{
+    const std::function<void(const Notification&)> profiled_handler = [&profiler, handler_id, handler](
+        const Notification& notification) {
+        const fc::time_point start = fc::time_point::now();
+        handler(notification);
+        profiler.add_handler_sample(handler_id, fc::time_point::now() - start);
+    };
+
+    if (!async)
+        return signal.connect(profiled_handler);
+
+    return signal.connect([&async_notifications, profiled_handler](const Notification& notification) {
+        async_notifications.hold(copy_notification(profiled_handler, notification));
+    });
+}
+}
+
+boost::signals2::connection
+database::connect_plugin_handler(const std::string& plugin,
+                                 fc::signal<void(const operation_notification&)>& signal,
+                                 const std::function<void(const operation_notification&)>& handler,
+                                 bool async)
+{
+    const uint16_t handler_id = _block_profiler.add_handler(plugin, signal_phase(&signal), async);
+    return connect_handler<operation_notification>(signal, handler, _block_profiler, handler_id, _async_notifications,
+                                                   async);
+}
+
+boost::signals2::connection database::connect_plugin_handler(const std::string& plugin,
+                                                             fc::signal<void(const signed_block&)>& signal,
+                                                             const std::function<void(const signed_block&)>& handler,
+                                                             bool async)
+{
+    const uint16_t handler_id = _block_profiler.add_handler(plugin, signal_phase(&signal), async);
+    return connect_handler<signed_block>(signal, handler, _block_profiler, handler_id, _async_notifications, async);
+}
+
+boost::signals2::connection
+database::connect_plugin_handler(const std::string& plugin,
+                                 fc::signal<void(const signed_transaction&)>& signal,
+                                 const std::function<void(const signed_transaction&)>& handler,
+                                 bool async)
+{
+    const uint16_t handler_id = _block_profiler.add_handler(plugin, signal_phase(&signal), async);
+    return connect_handler<signed_transaction>(signal, handler, _block_profiler, handler_id, _async_notifications,
+                                               async);
+}
+
+void database::flush_async_notifications()
+{
+    _async_notifications.flush();
+}
+
+uint16_t database::signal_phase(const void* signal) const
+{
+    if (signal == &pre_apply_operation)
+        return block_profiler::pre_apply_operation_signal;
+    if (signal == &post_apply_operation)
+        return block_profiler::post_apply_operation_signal;
+    if (signal == &pre_apply_block)
+        return block_profiler::pre_apply_block_signal;
+    if (signal == &applied_block)
+        return block_profiler::applied_block_signal;
+    if (signal == &on_pre_apply_transaction)
+        return block_profiler::pre_apply_transaction_signal;
+
+    FC_THROW_EXCEPTION(fc::assert_exception, "Plugin handlers can not be profiled for this signal.");
+}
+}
+}
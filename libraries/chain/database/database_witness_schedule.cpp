@@ -16,6 +16,8 @@ namespace chain {
  */
 void database::update_witness_schedule()
 {
+    block_profiler::scope profile(_block_profiler, block_profiler::update_witness_schedule);
+
     database& _db = (*this);
 
     if ((_db.head_block_num() % SCORUM_MAX_WITNESSES) == 0)
@@ -120,9 +122,19 @@ void database::update_witness_schedule()
             _wso.current_virtual_time = new_virtual_time;
         });
 
-        _update_witness_majority_version();
-        _update_witness_hardfork_version_votes();
-        _update_witness_median_props();
+        /// the scheduled witnesses are fetched once for all statistics of the round
+        auto& witness_service = _db.obtain_service<dbs_witness>();
+
+        std::vector<const witness_object*> scheduled;
+        scheduled.reserve(wso.num_scheduled_witnesses);
+        for (int i = 0; i < wso.num_scheduled_witnesses; i++)
+        {
+            scheduled.push_back(&witness_service.get(wso.current_shuffled_witnesses[i]));
+        }
+
+        _update_witness_majority_version(scheduled);
+        _update_witness_hardfork_version_votes(scheduled);
+        _update_witness_median_props(scheduled);
     }
 }
 
@@ -149,34 +161,26 @@ void database::_reset_witness_virtual_schedule_time()
     }
 }
 
-void database::_update_witness_median_props()
+void database::_update_witness_median_props(std::vector<const witness_object*> active)
 {
     // clang-format off
 
     database& _db = (*this);
 
-    const witness_schedule_object& wso = _db.obtain_service<dbs_witness_schedule>().get();
-    auto& witness_service = _db.obtain_service<dbs_witness>();
+    /// only the median has to be in place, the rest of the witnesses stay partially ordered
+    const auto median = active.begin() + active.size() / 2;
 
-    /// fetch all witness objects
-    std::vector<const witness_object*> active;
-    active.reserve(wso.num_scheduled_witnesses);
-    for (int i = 0; i < wso.num_scheduled_witnesses; i++)
-    {
-        active.push_back(&witness_service.get(wso.current_shuffled_witnesses[i]));
-    }
-
-    /// sort them by account_creation_fee
-    std::sort(active.begin(), active.end(), [&](const witness_object* a, const witness_object* b) {
+    /// select by account_creation_fee
+    std::nth_element(active.begin(), median, active.end(), [&](const witness_object* a, const witness_object* b) {
         return a->proposed_chain_props.account_creation_fee.amount < b->proposed_chain_props.account_creation_fee.amount;
     });
-    asset median_account_creation_fee = active[active.size() / 2]->proposed_chain_props.account_creation_fee;
+    asset median_account_creation_fee = (*median)->proposed_chain_props.account_creation_fee;
 
-    /// sort them by maximum_block_size
-    std::sort(active.begin(), active.end(), [&](const witness_object* a, const witness_object* b) {
+    /// select by maximum_block_size
+    std::nth_element(active.begin(), median, active.end(), [&](const witness_object* a, const witness_object* b) {
         return a->proposed_chain_props.maximum_block_size < b->proposed_chain_props.maximum_block_size;
     });
-    uint32_t median_maximum_block_size = active[active.size() / 2]->proposed_chain_props.maximum_block_size;
+    uint32_t median_maximum_block_size = (*median)->proposed_chain_props.maximum_block_size;
 
     _db.obtain_service<dbs_dynamic_global_property>().update([&](dynamic_global_property_object& _dgpo) {
         _dgpo.median_chain_props.account_creation_fee = median_account_creation_fee;
@@ -186,25 +190,15 @@ void database::_update_witness_median_props()
     // clang-format on
 }
 
-void database::_update_witness_majority_version()
+void database::_update_witness_majority_version(const std::vector<const witness_object*>& active)
 {
     database& _db = (*this);
 
-    const witness_schedule_object& wso = _db.obtain_service<dbs_witness_schedule>().get();
-    auto& witness_service = _db.obtain_service<dbs_witness>();
-
     flat_map<version, uint32_t, std::greater<version>> witness_versions;
-    for (uint32_t i = 0; i < wso.num_scheduled_witnesses; i++)
+    witness_versions.reserve(active.size());
+    for (const witness_object* witness : active)
     {
-        auto witness = witness_service.get(wso.current_shuffled_witnesses[i]);
-        if (witness_versions.find(witness.running_version) == witness_versions.end())
-        {
-            witness_versions[witness.running_version] = 1;
-        }
-        else
-        {
-            witness_versions[witness.running_version] += 1;
-        }
+        witness_versions[witness->running_version] += 1;
     }
 
     auto majority_version = _db.obtain_service<dbs_dynamic_global_property>().get().majority_version;
@@ -225,28 +219,16 @@ void database::_update_witness_majority_version()
         [&](dynamic_global_property_object& _dgpo) { _dgpo.majority_version = majority_version; });
 }
 
-void database::_update_witness_hardfork_version_votes()
+void database::_update_witness_hardfork_version_votes(const std::vector<const witness_object*>& active)
 {
     database& _db = (*this);
 
-    const witness_schedule_object& wso = _db.obtain_service<dbs_witness_schedule>().get();
-    auto& witness_service = _db.obtain_service<dbs_witness>();
-
     flat_map<std::tuple<hardfork_version, time_point_sec>, uint32_t> hardfork_version_votes;
+    hardfork_version_votes.reserve(active.size());
 
-    for (uint32_t i = 0; i < wso.num_scheduled_witnesses; i++)
+    for (const witness_object* witness : active)
     {
-        auto witness = witness_service.get(wso.current_shuffled_witnesses[i]);
-
-        auto version_vote = std::make_tuple(witness.hardfork_version_vote, witness.hardfork_time_vote);
-        if (hardfork_version_votes.find(version_vote) == hardfork_version_votes.end())
-        {
-            hardfork_version_votes[version_vote] = 1;
-        }
-        else
-        {
-            hardfork_version_votes[version_vote] += 1;
-        }
+        hardfork_version_votes[std::make_tuple(witness->hardfork_version_vote, witness->hardfork_time_vote)] += 1;
     }
 
     auto hf_itr = hardfork_version_votes.begin();
@@ -0,0 +1,136 @@
+#include <scorum/chain/database/notification_queue.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/log/logger.hpp>
+
+namespace scorum {
+namespace chain {
+
+const size_t notification_queue::default_max_size;
+
+notification_queue::~notification_queue()
+{
+    stop();
+}
+
+void notification_queue::set_max_size(size_t max_size)
+{
+    FC_ASSERT(max_size > 0, "Notification queue should not be empty.");
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _max_size = max_size;
+}
+
+void notification_queue::push(std::function<void()>&& call)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if (!_thread.joinable())
+    {
+        _stopping = false;
+        _thread = std::thread([this]() { run(); });
+    }
+
+    _popped.wait(lock, [this]() { return _calls.size() < _max_size; });
+
+    _calls.push_back(std::move(call));
+    _pushed.notify_one();
+}
+
+void notification_queue::begin_block()
+{
+    _held.clear();
+    _holding = true;
+}
+
+void notification_queue::hold(std::function<void()>&& call)
+{
+    if (_holding)
+        _held.push_back(std::move(call));
+}
+
+void notification_queue::commit_block()
+{
+    _holding = false;
+
+    for (auto& call : _held)
+        push(std::move(call));
+
+    _held.clear();
+}
+
+void notification_queue::discard_block()
+{
+    _holding = false;
+    _held.clear();
+}
+
+void notification_queue::flush()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _popped.wait(lock, [this]() { return _calls.empty() && !_calling; });
+}
+
+void notification_queue::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_thread.joinable())
+            return;
+
+        _stopping = true;
+        _pushed.notify_one();
+    }
+
+    _thread.join();
+    _thread = std::thread();
+}
+
+size_t notification_queue::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _calls.size() + (_calling ? 1 : 0);
+}
+
+void notification_queue::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    for (;;)
+    {
+        _pushed.wait(lock, [this]() { return !_calls.empty() || _stopping; });
+
+        if (_calls.empty())
+            return;
+
+        std::function<void()> call = std::move(_calls.front());
+        _calls.pop_front();
+        _calling = true;
+
+        lock.unlock();
+
+        try
+        {
+            call();
+        }
+        catch (const fc::exception& e)
+        {
+            elog("Caught exception in async plugin: ${e}", ("e", e.to_detail_string()));
+        }
+        catch (const std::exception& e)
+        {
+            elog("Caught exception in async plugin: ${e}", ("e", e.what()));
+        }
+        catch (...)
+        {
+            elog("Caught unknown exception in async plugin");
+        }
+
+        lock.lock();
+
+        _calling = false;
+        _popped.notify_all();
+    }
+}
+}
+}
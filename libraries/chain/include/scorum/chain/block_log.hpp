@@ -47,6 +47,7 @@ public:
     bool is_open() const;
 
     uint64_t append(const signed_block& b);
+    uint64_t append(const signed_block& b, const block_id_type& block_id);
     void flush();
     std::pair<signed_block, uint64_t> read_block(uint64_t file_pos) const;
     optional<signed_block> read_block_by_num(uint32_t block_num) const;
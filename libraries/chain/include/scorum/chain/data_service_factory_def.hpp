@@ -1,11 +1,14 @@
 #pragma once
 
+#include <boost/config.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
 
 #define DECLARE_SERVICE_FUNCT_NAME(service) BOOST_PP_CAT(service, _service)
 
 #define DECLARE_SERVICE_INTERFACE_NAME(service) BOOST_PP_CAT(DECLARE_SERVICE_FUNCT_NAME(service), _i)
 
+#define DECLARE_SERVICE_PTR_NAME(service) BOOST_PP_CAT(_, DECLARE_SERVICE_FUNCT_NAME(service))
+
 #define DECLARE_DBS_IMPL_NAME(service) BOOST_PP_CAT(dbs_, service)
 
 #define DECLARE_SERVICE_INTERFACE(_1, _2, service) struct DECLARE_SERVICE_INTERFACE_NAME(service);
@@ -19,6 +22,9 @@
     virtual DECLARE_SERVICE_INTERFACE_NAME(service)                                                                    \
         & BOOST_PP_CAT(DECLARE_SERVICE_FUNCT_NAME(service), BOOST_PP_EMPTY())();
 
+#define DECLARE_SERVICE_PTR(_1, _2, service)                                                                           \
+    DECLARE_SERVICE_INTERFACE_NAME(service)* DECLARE_SERVICE_PTR_NAME(service) = nullptr;
+
 #define DATA_SERVICE_FACTORY_DECLARE(SERVICES)                                                                         \
     namespace scorum {                                                                                                 \
     namespace chain {                                                                                                  \
@@ -41,8 +47,13 @@
                                                                                                                        \
         BOOST_PP_SEQ_FOR_EACH(DECLARE_FACTORY_METHOD, _, SERVICES)                                                     \
                                                                                                                        \
+        /* instantiates all services so the methods above return them without a lookup */                              \
+        void bind_services();                                                                                          \
+                                                                                                                       \
     private:                                                                                                           \
         scorum::chain::dbservice_dbs_factory& factory;                                                                 \
+                                                                                                                       \
+        BOOST_PP_SEQ_FOR_EACH(DECLARE_SERVICE_PTR, _, SERVICES)                                                        \
     };                                                                                                                 \
     }                                                                                                                  \
     }
@@ -51,9 +62,13 @@
     DECLARE_SERVICE_INTERFACE_NAME(service)                                                                            \
     &data_service_factory::BOOST_PP_CAT(DECLARE_SERVICE_FUNCT_NAME(service), BOOST_PP_EMPTY())()                       \
     {                                                                                                                  \
-        return factory.obtain_service<DECLARE_DBS_IMPL_NAME(service)>();                                               \
+        if (BOOST_UNLIKELY(DECLARE_SERVICE_PTR_NAME(service) == nullptr))                                              \
+            DECLARE_SERVICE_PTR_NAME(service) = &factory.obtain_service<DECLARE_DBS_IMPL_NAME(service)>();             \
+        return *DECLARE_SERVICE_PTR_NAME(service);                                                                     \
     }
 
+#define BIND_FACTORY_SERVICE(_1, _2, service) BOOST_PP_CAT(DECLARE_SERVICE_FUNCT_NAME(service), BOOST_PP_EMPTY())();
+
 #define DATA_SERVICE_FACTORY_IMPL(SERVICES)                                                                            \
     namespace scorum {                                                                                                 \
     namespace chain {                                                                                                  \
@@ -64,6 +79,11 @@
                                                                                                                        \
     data_service_factory::~data_service_factory()                                                                      \
     {                                                                                                                  \
+    }                                                                                                                  \
+                                                                                                                       \
+    void data_service_factory::bind_services()                                                                         \
+    {                                                                                                                  \
+        BOOST_PP_SEQ_FOR_EACH(BIND_FACTORY_SERVICE, _, SERVICES)                                                       \
     }                                                                                                                  \
     BOOST_PP_SEQ_FOR_EACH(DECLARE_FACTORY_METHOD_IMPL, _, SERVICES)                                                    \
     }                                                                                                                  \
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <scorum/protocol/operations.hpp>
+
+#include <fc/reflect/reflect.hpp>
+#include <fc/time.hpp>
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace scorum {
+namespace chain {
+
+using scorum::protocol::operation;
+
+struct block_phase_stats
+{
+    std::string phase;
+    uint64_t count = 0;
+    int64_t total_us = 0;
+    int64_t max_us = 0;
+
+    /// histogram[i] is the number of samples that took less than 2^i microseconds (and not less than 2^(i-1)),
+    /// the last bucket holds all slower samples
+    std::vector<uint64_t> histogram;
+};
+
+struct plugin_handler_stats
+{
+    std::string plugin;
+    std::string signal;
+    bool async = false;
+    uint64_t count = 0;
+    int64_t total_us = 0;
+    int64_t max_us = 0;
+    std::vector<uint64_t> histogram;
+};
+
+struct block_profile
+{
+    uint32_t first_block = 0;
+    uint32_t last_block = 0;
+
+    std::vector<block_phase_stats> phases;
+    std::vector<plugin_handler_stats> handlers;
+};
+
+/**
+ * Measures the phases of block application: the block checks, every transaction, the evaluator of every operation
+ * type, the block tasks, the clean up steps and the plugin signals.
+ *
+ * Samples are taken only while a block is applied, so pending and produced transactions are not counted twice.
+ * Histograms are kept for a rolling window: the statistics cover the last window_blocks to 2 * window_blocks blocks.
+ * The phases of a block can be logged when the block took more than the dump threshold.
+ *
+ * The handlers that plugins connect to the signals are measured one by one. Handlers of async-safe plugins are
+ * sampled on the notification thread, the time they spend there is not a part of the block.
+ */
+class block_profiler
+{
+public:
+    enum phase_type : uint16_t
+    {
+        block = 0,
+        merkle_check,
+        validate_block_header,
+        pre_apply_block_signal,
+        transaction,
+        pre_apply_transaction_signal,
+        pre_apply_operation_signal,
+        post_apply_operation_signal,
+        update_witness_schedule,
+        process_funds,
+        process_comments_cashout,
+        process_vesting_withdrawals,
+        clear_expired_transactions,
+        clear_expired_delegations,
+        applied_block_signal,
+        phases_count
+    };
+
+    static const size_t histogram_buckets = 24;
+    static const uint32_t default_window_blocks = 1200;
+
+    /**
+     * Adds the time spent in the scope to the phase
+     */
+    class scope
+    {
+    public:
+        scope(block_profiler& profiler, uint16_t phase)
+            : _profiler(profiler)
+            , _phase(phase)
+        {
+            if (_profiler.in_block())
+                _start = fc::time_point::now();
+        }
+
+        ~scope()
+        {
+            if (_start != fc::time_point())
+                _profiler.add(_phase, fc::time_point::now() - _start);
+        }
+
+    private:
+        block_profiler& _profiler;
+        const uint16_t _phase;
+        fc::time_point _start;
+    };
+
+    block_profiler();
+
+    /// evaluator phase of the operation type
+    static uint16_t evaluator_phase(const operation& op)
+    {
+        return phases_count + op.which();
+    }
+
+    static std::string phase_name(uint16_t phase);
+
+    void begin_block(uint32_t block_num);
+    void end_block();
+    /// drops the block that failed to apply, its samples stay in the histograms
+    void cancel_block();
+
+    bool in_block() const
+    {
+        return _in_block;
+    }
+
+    void add(uint16_t phase, const fc::microseconds& elapsed);
+
+    /// registers a handler of the plugin connected to the signal phase, returns the id of the handler samples
+    uint16_t add_handler(const std::string& plugin, uint16_t signal, bool async);
+
+    /// adds the time spent in the handler, samples of async handlers can be added from any thread
+    void add_handler_sample(uint16_t handler, const fc::microseconds& elapsed);
+
+    void set_window(uint32_t window_blocks);
+
+    /// blocks applied slower than the threshold are logged with their phases, zero logs every block
+    void set_dump_threshold(const fc::microseconds& threshold);
+    void disable_dump();
+
+    /// statistics of the rolling window
+    block_profile get_profile() const;
+
+    /// time spent in the phases of the last applied block
+    block_profile get_last_block_profile() const;
+
+    void reset();
+
+private:
+    struct histogram
+    {
+        uint64_t count = 0;
+        int64_t total_us = 0;
+        int64_t max_us = 0;
+        std::array<uint64_t, histogram_buckets> buckets = {};
+
+        void add(int64_t us);
+        void merge(const histogram& other);
+    };
+
+    struct block_sample
+    {
+        uint64_t count = 0;
+        int64_t total_us = 0;
+    };
+
+    struct handler_info
+    {
+        std::string plugin;
+        uint16_t signal;
+        bool async;
+    };
+
+    void dump() const;
+
+    uint32_t _window_blocks = default_window_blocks;
+
+    std::vector<histogram> _current;
+    std::vector<histogram> _previous;
+    uint32_t _current_first_block = 0;
+    uint32_t _previous_first_block = 0;
+    uint32_t _current_blocks = 0;
+
+    std::vector<block_sample> _block;
+    std::vector<block_sample> _last_block;
+    uint32_t _block_num = 0;
+    uint32_t _last_block_num = 0;
+    fc::time_point _block_start;
+    bool _in_block = false;
+
+    bool _dump = false;
+    fc::microseconds _dump_threshold;
+
+    std::vector<handler_info> _handlers;
+    std::vector<histogram> _handlers_current;
+    std::vector<histogram> _handlers_previous;
+    mutable std::mutex _handlers_mutex;
+};
+}
+}
+
+FC_REFLECT(scorum::chain::block_phase_stats, (phase)(count)(total_us)(max_us)(histogram))
+FC_REFLECT(scorum::chain::plugin_handler_stats, (plugin)(signal)(async)(count)(total_us)(max_us)(histogram))
+FC_REFLECT(scorum::chain::block_profile, (first_block)(last_block)(phases)(handlers))
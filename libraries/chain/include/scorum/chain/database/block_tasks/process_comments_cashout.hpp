@@ -4,6 +4,8 @@
 
 #include <scorum/chain/services/comment.hpp>
 
+#include <map>
+
 namespace scorum {
 namespace chain {
 namespace database_ns {
@@ -13,11 +15,22 @@ struct process_comments_cashout : public block_task
     virtual void on_apply(block_task_context&);
 
 private:
+    /// curation rewards of all comments paid in the block, summed per voter
+    using curation_rewards_type = std::map<account_id_type, asset>;
+
     uint128_t get_recent_claims(block_task_context& ctx, const comment_service_i::comment_refs_type&);
 
-    asset pay_for_comment(block_task_context& ctx, const comment_object& comment, const asset& reward);
+    asset pay_for_comment(block_task_context& ctx,
+                          const comment_object& comment,
+                          const asset& reward,
+                          curation_rewards_type& curation_rewards);
+
+    asset pay_curators(block_task_context& ctx,
+                       const comment_object& comment,
+                       asset& max_rewards,
+                       curation_rewards_type& curation_rewards);
 
-    asset pay_curators(block_task_context& ctx, const comment_object& comment, asset& max_rewards);
+    void pay_curation_rewards(block_task_context& ctx, const curation_rewards_type& curation_rewards);
 };
 }
 }
@@ -7,6 +7,8 @@
 #include <scorum/chain/hardfork.hpp>
 #include <scorum/chain/node_property_object.hpp>
 #include <scorum/chain/database/fork_database.hpp>
+#include <scorum/chain/database/block_profiler.hpp>
+#include <scorum/chain/database/notification_queue.hpp>
 #include <scorum/chain/block_log.hpp>
 #include <scorum/chain/operation_notification.hpp>
 
@@ -206,10 +208,12 @@ public:
     inline void push_virtual_operation(const operation& op);
     inline void push_hf_operation(const operation& op);
 
+    void notify_pre_apply_block(const signed_block& block);
     void notify_applied_block(const signed_block& block);
     void notify_on_pending_transaction(const signed_transaction& tx);
     void notify_on_pre_apply_transaction(const signed_transaction& tx);
     void notify_on_applied_transaction(const signed_transaction& tx);
+    void notify_on_clear_pending();
 
     /**
      *  This signal is emitted for plugins to process every operation after it has been fully applied.
@@ -217,6 +221,12 @@ public:
     fc::signal<void(const operation_notification&)> pre_apply_operation;
     fc::signal<void(const operation_notification&)> post_apply_operation;
 
+    /**
+     *  This signal is emitted when the block header has been validated and before
+     *  any transaction of the block is applied.
+     */
+    fc::signal<void(const signed_block&)> pre_apply_block;
+
     /**
      *  This signal is emitted after all operations and virtual operation for a
      *  block have been applied but before the get_applied_operations() are cleared.
@@ -245,6 +255,38 @@ public:
      */
     fc::signal<void(const signed_transaction&)> on_applied_transaction;
 
+    /**
+     * This signal is emitted any time the pending block state is thrown away. Pending transactions applied again
+     * after it are announced by on_pre_apply_transaction once more.
+     */
+    fc::signal<void()> on_clear_pending;
+
+    /**
+     * Connects a handler of the plugin to pre_apply_operation, post_apply_operation, pre_apply_block, applied_block
+     * or on_pre_apply_transaction. The time spent in the handler is profiled per plugin, see block_profiler.
+     *
+     * Handlers of async-safe plugins are called on the notification thread with a copy of the notification after the
+     * database has moved on. They must not read the chain state, their exceptions are logged only. They are notified
+     * only of blocks the node has applied, once the whole block is applied: pending transactions and their
+     * reapplication are not notified. Blocks popped later (fork switch) are not retracted.
+     */
+    boost::signals2::connection
+    connect_plugin_handler(const std::string& plugin,
+                           fc::signal<void(const operation_notification&)>& signal,
+                           const std::function<void(const operation_notification&)>& handler,
+                           bool async = false);
+    boost::signals2::connection connect_plugin_handler(const std::string& plugin,
+                                                       fc::signal<void(const signed_block&)>& signal,
+                                                       const std::function<void(const signed_block&)>& handler,
+                                                       bool async = false);
+    boost::signals2::connection connect_plugin_handler(const std::string& plugin,
+                                                       fc::signal<void(const signed_transaction&)>& signal,
+                                                       const std::function<void(const signed_transaction&)>& handler,
+                                                       bool async = false);
+
+    /// waits until the handlers of async-safe plugins have got all emitted notifications
+    void flush_async_notifications();
+
     //////////////////// db_witness_schedule.cpp ////////////////////
 
     /**
@@ -324,6 +366,29 @@ public:
     void set_flush_interval(uint32_t flush_blocks);
     void show_free_memory(bool force);
 
+    /**
+     * Grows the shared memory file by grow_size when its free memory falls under min_free. It is done between blocks,
+     * so references to objects must not be kept across push_block. Zero grow_size disables it.
+     */
+    void set_shared_memory_growth(uint64_t min_free, uint64_t grow_size);
+
+    /**
+     * Rewrites the shared memory file into a fresh file of shared_file_size bytes, so the memory left in holes by
+     * removed objects is reclaimed. It is done on start, after open has undone the reversible blocks.
+     */
+    void compact_shared_memory(uint64_t shared_file_size);
+
+    /// time spent in the phases of block application, see block_profiler
+    block_profiler& get_block_profiler()
+    {
+        return _block_profiler;
+    }
+
+    const block_profiler& get_block_profiler() const
+    {
+        return _block_profiler;
+    }
+
     // index
 
     template <typename MultiIndexType> void add_plugin_index()
@@ -339,9 +404,9 @@ private:
     // witness_schedule
     void update_witness_schedule();
     void _reset_witness_virtual_schedule_time();
-    void _update_witness_median_props();
-    void _update_witness_majority_version();
-    void _update_witness_hardfork_version_votes();
+    void _update_witness_median_props(std::vector<const witness_object*> active);
+    void _update_witness_majority_version(const std::vector<const witness_object*>& active);
+    void _update_witness_hardfork_version_votes(const std::vector<const witness_object*>& active);
 
     void _maybe_warn_multiple_production(uint32_t height) const;
     bool _push_block(const signed_block& b);
@@ -352,6 +417,11 @@ private:
 
     uint32_t get_last_irreversible_block_num() const;
 
+    void maybe_grow_shared_memory();
+
+    /// profiler phase of the signal that plugins can connect to
+    uint16_t signal_phase(const void* signal) const;
+
 protected:
     void set_producing(bool p)
     {
@@ -359,8 +429,10 @@ protected:
     }
 
     void apply_block(const signed_block& next_block, uint32_t skip = skip_nothing);
+    /// used by callers that already know the block id, e.g. from the fork database item
+    void apply_block(const signed_block& next_block, const block_id_type& next_block_id, uint32_t skip);
     void apply_transaction(const signed_transaction& trx, uint32_t skip = skip_nothing);
-    void _apply_block(const signed_block& next_block);
+    void _apply_block(const signed_block& next_block, const block_id_type& next_block_id);
     void _apply_transaction(const signed_transaction& trx);
     void apply_operation(const operation& op);
 
@@ -368,9 +440,9 @@ protected:
     ///@{
 
     const witness_object& validate_block_header(uint32_t skip, const signed_block& next_block) const;
-    void create_block_summary(const signed_block& next_block);
+    void create_block_summary(const signed_block& next_block, const block_id_type& next_block_id);
 
-    void update_global_dynamic_data(const signed_block& b);
+    void update_global_dynamic_data(const signed_block& b, const block_id_type& block_id);
     void update_signing_witness(const witness_object& signing_witness, const signed_block& new_block);
     void update_last_irreversible_block();
     void clear_expired_transactions();
@@ -412,6 +484,12 @@ private:
 
     uint32_t _last_free_gb_printed = 0;
 
+    uint64_t _shared_memory_min_free = 0;
+    uint64_t _shared_memory_grow_size = 0;
+
+    block_profiler _block_profiler;
+    notification_queue _async_notifications;
+
     fc::time_point_sec _const_genesis_time; // should be const
 };
 } // namespace chain
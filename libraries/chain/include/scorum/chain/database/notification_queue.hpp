@@ -0,0 +1,76 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace scorum {
+namespace chain {
+
+/**
+ * Calls the handlers of async-safe plugins on a dedicated thread, in the order the notifications were emitted.
+ *
+ * The queue is bounded: when it is full the database waits for the thread, so a slow plugin slows block application
+ * down instead of growing the memory without limit.
+ *
+ * Notifications of a block are held until the block has been applied, those emitted outside of a block (pending
+ * transactions and their reapplication) are dropped. The holding methods are called by the database thread only.
+ */
+class notification_queue
+{
+public:
+    static const size_t default_max_size = 10000;
+
+    notification_queue() = default;
+    notification_queue(const notification_queue&) = delete;
+    notification_queue& operator=(const notification_queue&) = delete;
+
+    ~notification_queue();
+
+    void set_max_size(size_t max_size);
+
+    /// queues the call, the thread is started by the first call
+    void push(std::function<void()>&& call);
+
+    /// starts holding the calls of a block being applied
+    void begin_block();
+
+    /// holds the call until the block is applied, drops it if no block is being applied
+    void hold(std::function<void()>&& call);
+
+    /// queues the calls held for the applied block
+    void commit_block();
+
+    /// drops the calls held for a block that failed to apply
+    void discard_block();
+
+    /// waits until all queued calls are done
+    void flush();
+
+    /// calls the queued calls and stops the thread
+    void stop();
+
+    size_t size() const;
+
+private:
+    void run();
+
+    size_t _max_size = default_max_size;
+
+    std::vector<std::function<void()>> _held;
+    bool _holding = false;
+
+    std::deque<std::function<void()>> _calls;
+    bool _calling = false;
+    bool _stopping = false;
+
+    std::thread _thread;
+    mutable std::mutex _mutex;
+    std::condition_variable _pushed;
+    std::condition_variable _popped;
+};
+}
+}
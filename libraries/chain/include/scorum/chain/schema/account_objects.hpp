@@ -166,11 +166,6 @@ public:
 
 struct by_name;
 struct by_proxy;
-struct by_last_post;
-struct by_scorum_balance;
-struct by_smp_balance;
-struct by_post_count;
-struct by_vote_count;
 struct by_created_by_genesis;
 
 /**
@@ -199,58 +194,7 @@ typedef shared_multi_index_container<account_object,
                                                                                     &account_object::id>> /// composite
                                                                /// key by
                                                                /// proxy
-                                                               >,
-                                                ordered_unique<tag<by_last_post>,
-                                                               composite_key<account_object,
-                                                                             member<account_object,
-                                                                                    time_point_sec,
-                                                                                    &account_object::last_post>,
-                                                                             member<account_object,
-                                                                                    account_id_type,
-                                                                                    &account_object::id>>,
-                                                               composite_key_compare<std::greater<time_point_sec>,
-                                                                                     std::less<account_id_type>>>,
-                                                ordered_unique<tag<by_scorum_balance>,
-                                                               composite_key<account_object,
-                                                                             member<account_object,
-                                                                                    asset,
-                                                                                    &account_object::balance>,
-                                                                             member<account_object,
-                                                                                    account_id_type,
-                                                                                    &account_object::id>>,
-                                                               composite_key_compare<std::greater<asset>,
-                                                                                     std::less<account_id_type>>>,
-                                                ordered_unique<tag<by_smp_balance>,
-                                                               composite_key<account_object,
-                                                                             member<account_object,
-                                                                                    asset,
-                                                                                    &account_object::scorumpower>,
-                                                                             member<account_object,
-                                                                                    account_id_type,
-                                                                                    &account_object::id>>,
-                                                               composite_key_compare<std::greater<asset>,
-                                                                                     std::less<account_id_type>>>,
-                                                ordered_unique<tag<by_post_count>,
-                                                               composite_key<account_object,
-                                                                             member<account_object,
-                                                                                    uint32_t,
-                                                                                    &account_object::post_count>,
-                                                                             member<account_object,
-                                                                                    account_id_type,
-                                                                                    &account_object::id>>,
-                                                               composite_key_compare<std::greater<uint32_t>,
-                                                                                     std::less<account_id_type>>>,
-                                                ordered_unique<tag<by_vote_count>,
-                                                               composite_key<account_object,
-                                                                             member<account_object,
-                                                                                    uint32_t,
-                                                                                    &account_object::
-                                                                                        lifetime_vote_count>,
-                                                                             member<account_object,
-                                                                                    account_id_type,
-                                                                                    &account_object::id>>,
-                                                               composite_key_compare<std::greater<uint32_t>,
-                                                                                     std::less<account_id_type>>>>>
+                                                               >>>
     account_index;
 
 struct by_account;
@@ -14,17 +14,19 @@ using scorum::protocol::signed_transaction;
  * The purpose of this object is to enable the detection of duplicate transactions. When a transaction is included
  * in a block a transaction_object is added. At the end of block processing all transaction_objects that have
  * expired can be removed from the index.
+ *
+ * Only the id is kept, the transaction itself is found in the pending queue or in the block it was included in.
  */
 class transaction_object : public object<transaction_object_type, transaction_object>
 {
 public:
-    CHAINBASE_DEFAULT_DYNAMIC_CONSTRUCTOR(transaction_object, (packed_trx))
+    CHAINBASE_DEFAULT_CONSTRUCTOR(transaction_object)
 
     id_type id;
 
-    fc::shared_buffer packed_trx;
     transaction_id_type trx_id;
     time_point_sec expiration;
+    uint32_t block_num = 0; ///< block the transaction was applied in (or is pending for)
 };
 
 struct by_expiration;
@@ -46,5 +48,5 @@ typedef shared_multi_index_container<transaction_object,
 }
 } // scorum::chain
 
-FC_REFLECT(scorum::chain::transaction_object, (id)(packed_trx)(trx_id)(expiration))
+FC_REFLECT(scorum::chain::transaction_object, (id)(trx_id)(expiration)(block_num))
 CHAINBASE_SET_INDEX_TYPE(scorum::chain::transaction_object, scorum::chain::transaction_index)
@@ -2,6 +2,8 @@
 
 #include <scorum/chain/services/dbs_base.hpp>
 
+#include <memory>
+
 namespace scorum {
 namespace chain {
 
@@ -131,6 +133,8 @@ struct account_service_i
     virtual void update(const account_object& obj, const modifier_type&) = 0;
 };
 
+struct account_authority_cache;
+
 // DB operations with account_*** objects
 //
 class dbs_account : public dbs_base, public account_service_i
@@ -141,6 +145,8 @@ protected:
     explicit dbs_account(database& db);
 
 public:
+    virtual ~dbs_account();
+
     virtual const account_object& get(const account_id_type&) const override;
 
     virtual const account_object& get_account(const account_name_type&) const override;
@@ -149,6 +155,12 @@ public:
 
     virtual const account_authority_object& get_account_authority(const account_name_type&) const override;
 
+    /**
+     * Authority of the account converted for signature verification. Converted authorities are cached for the
+     * current head block; see account_authority_cache.
+     */
+    authority get_authority(const account_name_type&, authority::classification) const;
+
     virtual void check_account_existence(const account_name_type&,
                                          const optional<const char*>& context_type_name
                                          = optional<const char*>()) const override;
@@ -271,6 +283,10 @@ private:
                                                   const authority& owner,
                                                   const authority& active,
                                                   const authority& posting);
+
+    void invalidate_authority_cache();
+
+    std::unique_ptr<account_authority_cache> _authority_cache;
 };
 } // namespace chain
 } // namespace scorum
@@ -39,6 +39,16 @@ public:
 
     time_point_sec head_block_time();
 
+    /// reads again pointers to objects of the shared memory kept by the service, called under the write lock
+    virtual void reset_cache()
+    {
+    }
+
+    /// drops pointers to objects of the shared memory kept by the service, called before it is unmapped
+    virtual void clear_cache()
+    {
+    }
+
 protected:
     database& db_impl();
     const database& db_impl() const;
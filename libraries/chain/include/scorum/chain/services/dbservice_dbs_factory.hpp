@@ -2,11 +2,9 @@
 
 #include <memory>
 #include <string>
-#include <typeinfo>
+#include <vector>
 
 #include <boost/config.hpp>
-#include <boost/type_index.hpp>
-#include <boost/container/flat_map.hpp>
 
 namespace scorum {
 namespace chain {
@@ -28,20 +26,30 @@ protected:
 public:
     template <typename ConcreteService> ConcreteService& obtain_service() const
     {
-        auto it = _dbs.find(boost::typeindex::type_id<ConcreteService>());
-        if (it == _dbs.end())
-        {
-            it = _dbs.insert(std::make_pair(boost::typeindex::type_id<ConcreteService>(),
-                                            BaseServicePtr(new ConcreteService(_db_core))))
-                     .first;
-        }
-
-        BaseServicePtr& ret = it->second;
+        // every service type gets its own slot once per process, so lookups cost an array access
+        static const size_t slot = next_service_slot();
+
+        if (BOOST_UNLIKELY(_dbs.size() <= slot))
+            _dbs.resize(slot + 1);
+
+        BaseServicePtr& ret = _dbs[slot];
+        if (BOOST_UNLIKELY(!ret))
+            ret.reset(new ConcreteService(_db_core));
+
         return static_cast<ConcreteService&>(*ret);
     }
 
+    /// reads again the objects cached by the services, must be called under the write lock whenever the shared
+    /// memory is mapped again
+    void reset_services_cache();
+
+    /// drops the objects cached by the services, must be called whenever the shared memory is unmapped
+    void clear_services_cache();
+
 private:
-    mutable boost::container::flat_map<boost::typeindex::type_index, BaseServicePtr> _dbs;
+    static size_t next_service_slot();
+
+    mutable std::vector<BaseServicePtr> _dbs;
     database& _db_core;
 };
 } // namespace chain
@@ -43,6 +43,12 @@ public:
     virtual void update(const modifier_type& modifier) override;
 
     virtual fc::time_point_sec head_block_time() const override;
+
+    virtual void reset_cache() override;
+    virtual void clear_cache() override;
+
+private:
+    const dynamic_global_property_object* _dgp = nullptr;
 };
 
 } // namespace chain
@@ -39,6 +39,12 @@ public:
     virtual void remove() override;
 
     virtual bool is_exists() const override;
+
+    virtual void reset_cache() override;
+    virtual void clear_cache() override;
+
+private:
+    const hardfork_property_object* _hfp = nullptr;
 };
 } // namespace chain
 } // namespace scorum
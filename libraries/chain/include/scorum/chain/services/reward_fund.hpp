@@ -31,6 +31,12 @@ public:
     const reward_fund_object& create(const modifier_type& modifier) override;
 
     void update(const modifier_type& modifier) override;
+
+    void reset_cache() override;
+    void clear_cache() override;
+
+private:
+    const reward_fund_object* _rf = nullptr;
 };
 
 } // namespace scorum
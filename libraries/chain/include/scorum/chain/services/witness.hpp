@@ -2,6 +2,8 @@
 
 #include <scorum/chain/services/dbs_base.hpp>
 
+#include <map>
+
 namespace scorum {
 namespace protocol {
 class chain_properties;
@@ -19,7 +21,8 @@ struct witness_service_i
 
     virtual bool is_exists(const account_name_type& owner) const = 0;
 
-    virtual const witness_object& get_top_witness() const = 0;
+    /** batched vote changes are applied first, so the order by votes is up to date */
+    virtual const witness_object& get_top_witness() = 0;
 
     virtual const witness_object& create_witness(const account_name_type& owner,
                                                  const std::string& url,
@@ -56,7 +59,7 @@ public:
 
     bool is_exists(const account_name_type& owner) const override;
 
-    const witness_object& get_top_witness() const override;
+    const witness_object& get_top_witness() override;
 
     const witness_object& create_witness(const account_name_type& owner,
                                          const std::string& url,
@@ -77,8 +80,22 @@ public:
     /** this is called by `adjust_proxied_witness_votes` when account proxy to self */
     void adjust_witness_votes(const account_object& account, const share_type& delta) override;
 
+    /**
+     * While a block is applied, vote changes are summed per witness and every touched witness is rebalanced once by
+     * flush_votes_batch instead of on every change. end_votes_batch drops what was not flushed (the block failed) and
+     * turns accumulation off.
+     */
+    void begin_votes_batch();
+    void flush_votes_batch();
+    void end_votes_batch();
+
 private:
     const witness_object& create_internal(const account_name_type& owner, const public_key_type& block_signing_key);
+
+    void apply_witness_vote(const witness_object& witness, const share_type& delta);
+
+    bool _batch_votes = false;
+    std::map<witness_id_type, share_type> _batched_votes;
 };
 } // namespace chain
 } // namespace scorum
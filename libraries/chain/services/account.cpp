@@ -9,8 +9,52 @@
 namespace scorum {
 namespace chain {
 
+/**
+ * Authorities are valid for the head block they were read at. A change of any authority empties the cache and turns
+ * it off until the head block changes: the change may be undone (failed or dropped transaction, popped block) without
+ * any notification, so nothing read after it may be kept.
+ */
+struct account_authority_cache
+{
+    struct authorities
+    {
+        explicit authorities(const account_authority_object& auth)
+            : owner(auth.owner)
+            , active(auth.active)
+            , posting(auth.posting)
+        {
+        }
+
+        authority owner;
+        authority active;
+        authority posting;
+
+        const authority& get(authority::classification type) const
+        {
+            switch (type)
+            {
+            case authority::owner:
+                return owner;
+            case authority::posting:
+                return posting;
+            default:
+                return active;
+            }
+        }
+    };
+
+    std::map<account_name_type, authorities> entries;
+    block_id_type head_block_id;
+    bool enabled = true;
+};
+
 dbs_account::dbs_account(database& db)
     : _base_type(db)
+    , _authority_cache(new account_authority_cache())
+{
+}
+
+dbs_account::~dbs_account()
 {
 }
 
@@ -32,6 +76,36 @@ const account_object& dbs_account::get_account(const account_name_type& name) co
     FC_CAPTURE_AND_RETHROW((name))
 }
 
+authority dbs_account::get_authority(const account_name_type& name, authority::classification type) const
+{
+    auto& cache = *_authority_cache;
+
+    const block_id_type head_block_id = db_impl().head_block_id();
+    if (cache.head_block_id != head_block_id)
+    {
+        cache.entries.clear();
+        cache.head_block_id = head_block_id;
+        cache.enabled = true;
+    }
+
+    auto itr = cache.entries.find(name);
+    if (itr != cache.entries.end())
+        return itr->second.get(type);
+
+    const auto& auth = get_account_authority(name);
+
+    if (!cache.enabled)
+        return account_authority_cache::authorities(auth).get(type);
+
+    return cache.entries.emplace(name, account_authority_cache::authorities(auth)).first->second.get(type);
+}
+
+void dbs_account::invalidate_authority_cache()
+{
+    _authority_cache->entries.clear();
+    _authority_cache->enabled = false;
+}
+
 bool dbs_account::is_exists(const account_name_type& name) const
 {
     return nullptr != db_impl().find<account_object, by_name>(name);
@@ -212,6 +286,8 @@ void dbs_account::update_acount(const account_object& account,
 
     if (active || posting)
     {
+        invalidate_authority_cache();
+
         db_impl().modify(account_authority, [&](account_authority_object& auth) {
             if (active)
                 auth.active = *active;
@@ -225,6 +301,8 @@ void dbs_account::update_owner_authority(const account_object& account, const au
 {
     time_point_sec t = db_impl().head_block_time();
 
+    invalidate_authority_cache();
+
     db_impl().create<owner_authority_history_object>([&](owner_authority_history_object& hist) {
         hist.account = account.name;
         hist.previous_owner_authority = db_impl().get<account_authority_object, by_account>(account.name).owner;
@@ -601,6 +679,8 @@ const account_object& dbs_account::_create_account_objects(const account_name_ty
 
     if (memo_key != public_key_type())
     {
+        invalidate_authority_cache();
+
         db_impl().create<account_authority_object>([&](account_authority_object& auth) {
             auth.account = new_account_name;
             auth.owner = owner;
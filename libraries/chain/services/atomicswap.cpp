@@ -140,29 +140,23 @@ void dbs_atomicswap::refund_contract(const atomicswap_contract_object& contract)
 
 void dbs_atomicswap::check_contracts_expiration()
 {
-    atomicswap_contracts_refs_type contracts;
-
-    const auto& idx = db_impl().get_index<atomicswap_contract_index>().indices().get<by_owner_name>();
-    for (auto it = idx.cbegin(); it != idx.cend(); ++it)
-    {
-        contracts.push_back(std::cref(*it));
-    }
+    const auto& idx = db_impl().get_index<atomicswap_contract_index>().indices().get<by_deadline>();
 
     const dynamic_global_property_object& props = db_impl().obtain_service<dbs_dynamic_global_property>().get();
 
-    for (const atomicswap_contract_object& contract : contracts)
+    // contracts are ordered by deadline, only the expired ones at the front of the index are visited
+    while (!idx.empty() && props.time >= idx.begin()->deadline)
     {
-        if (props.time >= contract.deadline)
+        const atomicswap_contract_object& contract = *idx.begin();
+
+        if (contract.secret.empty())
+        {
+            // only for initiator or not redeemed participant contracts
+            refund_contract(contract);
+        }
+        else
         {
-            if (contract.secret.empty())
-            {
-                // only for initiator or not redeemed participant contracts
-                refund_contract(contract);
-            }
-            else
-            {
-                db_impl().remove(contract);
-            }
+            db_impl().remove(contract);
         }
     }
 }
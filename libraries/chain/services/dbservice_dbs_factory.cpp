@@ -2,6 +2,8 @@
 #include <scorum/chain/services/dbs_base.hpp>
 #include <scorum/chain/database/database.hpp>
 
+#include <atomic>
+
 namespace scorum {
 namespace chain {
 
@@ -15,5 +17,29 @@ dbservice_dbs_factory::dbservice_dbs_factory(database& db)
 dbservice_dbs_factory::~dbservice_dbs_factory()
 {
 }
+
+void dbservice_dbs_factory::reset_services_cache()
+{
+    for (auto& service : _dbs)
+    {
+        if (service)
+            service->reset_cache();
+    }
+}
+
+void dbservice_dbs_factory::clear_services_cache()
+{
+    for (auto& service : _dbs)
+    {
+        if (service)
+            service->clear_cache();
+    }
+}
+
+size_t dbservice_dbs_factory::next_service_slot()
+{
+    static std::atomic<size_t> slots_count(0);
+    return slots_count++;
+}
 }
 }
@@ -21,6 +21,9 @@ const dynamic_global_property_object& dbs_dynamic_global_property::get() const
 {
     try
     {
+        // the object is read by reset_cache(), it is looked up until the object is created
+        if (BOOST_LIKELY(_dgp != nullptr))
+            return *_dgp;
         return db_impl().get<dynamic_global_property_object>();
     }
     FC_CAPTURE_AND_RETHROW()
@@ -41,6 +44,16 @@ void dbs_dynamic_global_property::update(const modifier_type& modifier)
     db_impl().modify(get(), [&](dynamic_global_property_object& o) { modifier(o); });
 }
 
+void dbs_dynamic_global_property::reset_cache()
+{
+    _dgp = db_impl().find<dynamic_global_property_object>();
+}
+
+void dbs_dynamic_global_property::clear_cache()
+{
+    _dgp = nullptr;
+}
+
 fc::time_point_sec dbs_dynamic_global_property::head_block_time() const
 {
     return get().time;
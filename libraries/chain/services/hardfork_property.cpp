@@ -19,6 +19,9 @@ const hardfork_property_object& dbs_hardfork_property::get() const
 {
     try
     {
+        // the object is read by reset_cache(), it is looked up until the object is created
+        if (BOOST_LIKELY(_hfp != nullptr))
+            return *_hfp;
         return db_impl().get<hardfork_property_object>();
     }
     FC_CAPTURE_AND_RETHROW()
@@ -32,6 +35,7 @@ void dbs_hardfork_property::update(const modifier_type& modifier)
 void dbs_hardfork_property::remove()
 {
     db_impl().remove(get());
+    _hfp = nullptr;
 }
 
 bool dbs_hardfork_property::is_exists() const
@@ -39,5 +43,15 @@ bool dbs_hardfork_property::is_exists() const
     return nullptr != db_impl().find<hardfork_property_object>();
 }
 
+void dbs_hardfork_property::reset_cache()
+{
+    _hfp = db_impl().find<hardfork_property_object>();
+}
+
+void dbs_hardfork_property::clear_cache()
+{
+    _hfp = nullptr;
+}
+
 } // namespace chain
 } // namespace scorum
@@ -13,6 +13,9 @@ dbs_reward_fund::dbs_reward_fund(database& db)
 
 const reward_fund_object& dbs_reward_fund::get() const
 {
+    // the object is read by reset_cache(), it is looked up until the object is created
+    if (BOOST_LIKELY(_rf != nullptr))
+        return *_rf;
     return db_impl().get<reward_fund_object>();
 }
 
@@ -26,5 +29,15 @@ void dbs_reward_fund::update(const modifier_type& modifier)
     db_impl().modify(get(), [&](reward_fund_object& o) { modifier(o); });
 }
 
+void dbs_reward_fund::reset_cache()
+{
+    _rf = db_impl().find<reward_fund_object>();
+}
+
+void dbs_reward_fund::clear_cache()
+{
+    _rf = nullptr;
+}
+
 } // namespace scorum
 } // namespace chain
@@ -30,8 +30,10 @@ bool dbs_witness::is_exists(const account_name_type& name) const
     return nullptr != db_impl().find<witness_object, by_name>(name);
 }
 
-const witness_object& dbs_witness::get_top_witness() const
+const witness_object& dbs_witness::get_top_witness()
 {
+    flush_votes_batch();
+
     const auto& idx = db_impl().get_index<witness_index>().indices().get<by_vote_name>();
     FC_ASSERT(idx.begin() != idx.end(), "Empty witness_index by_vote_name.");
     return (*idx.begin());
@@ -106,6 +108,42 @@ void dbs_witness::adjust_witness_votes(const account_object& account, const shar
 }
 
 void dbs_witness::adjust_witness_vote(const witness_object& witness, const share_type& delta)
+{
+    if (_batch_votes)
+    {
+        // zero sums are kept too, the witness is still rebalanced to the current virtual time
+        _batched_votes[witness.id] += delta;
+        return;
+    }
+
+    apply_witness_vote(witness, delta);
+}
+
+void dbs_witness::begin_votes_batch()
+{
+    _batched_votes.clear();
+    _batch_votes = true;
+}
+
+void dbs_witness::flush_votes_batch()
+{
+    // current_virtual_time does not change between flushes, so a single adjustment by the sum leaves the witness in
+    // the same state as the sequence of adjustments it replaces
+    for (const auto& vote : _batched_votes)
+    {
+        apply_witness_vote(db_impl().get(vote.first), vote.second);
+    }
+
+    _batched_votes.clear();
+}
+
+void dbs_witness::end_votes_batch()
+{
+    _batched_votes.clear();
+    _batch_votes = false;
+}
+
+void dbs_witness::apply_witness_vote(const witness_object& witness, const share_type& delta)
 {
     const auto& props = db_impl().obtain_service<dbs_dynamic_global_property>().get();
 
@@ -19,6 +19,9 @@ const witness_schedule_object& dbs_witness_schedule::get() const
 {
     try
     {
+        // the object is read by reset_cache(), it is looked up until the object is created
+        if (BOOST_LIKELY(_wso != nullptr))
+            return *_wso;
         return db_impl().get<witness_schedule_object>();
     }
     FC_CAPTURE_AND_RETHROW()
@@ -32,6 +35,7 @@ void dbs_witness_schedule::update(const modifier_type& modifier)
 void dbs_witness_schedule::remove()
 {
     db_impl().remove(get());
+    _wso = nullptr;
 }
 
 bool dbs_witness_schedule::is_exists() const
@@ -39,5 +43,15 @@ bool dbs_witness_schedule::is_exists() const
     return nullptr != db_impl().find<witness_schedule_object>();
 }
 
+void dbs_witness_schedule::reset_cache()
+{
+    _wso = db_impl().find<witness_schedule_object>();
+}
+
+void dbs_witness_schedule::clear_cache()
+{
+    _wso = nullptr;
+}
+
 } // namespace chain
 } // namespace scorum
@@ -0,0 +1,514 @@
+#include <chainbase/chainbase.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// Measures the basic operations of generic_index and of the undo state on a shared memory file.
+//
+// Usage: chainbase_bench [--dir=<path>] [--objects=<n>] [--sessions=<n>] [--filter=<group>]
+//
+//  --dir       where the shared memory files are created, /dev/shm (tmpfs) by default
+//  --objects   number of objects created by every objects/* group
+//  --sessions  number of undo sessions opened by every undo/* and commit/* group
+//  --filter    run only the groups whose name contains the given string
+
+using namespace boost::multi_index;
+
+namespace chainbase_bench {
+
+struct by_id;
+struct by_key;
+struct by_group;
+struct by_group_key;
+
+/**
+ * Object of a benchmark, every combination of payload size and number of secondary indexes needs its own type number
+ * because the indexes are registered by type_id.
+ */
+template <uint16_t TypeNumber, size_t PayloadSize, int SecondaryIndexes>
+struct bench_object : public chainbase::object<TypeNumber, bench_object<TypeNumber, PayloadSize, SecondaryIndexes>>
+{
+    CHAINBASE_DEFAULT_CONSTRUCTOR(bench_object)
+
+    typedef typename chainbase::object<TypeNumber, bench_object>::id_type id_type;
+
+    static const size_t payload_size = PayloadSize;
+    static const int secondary_indexes = SecondaryIndexes;
+
+    id_type id;
+    int64_t key = 0;
+    int64_t group = 0;
+    char payload[PayloadSize];
+};
+
+template <typename Object, int SecondaryIndexes> struct bench_index_type;
+
+template <typename Object> struct bench_index_type<Object, 0>
+{
+    typedef fc::shared_multi_index_container<Object,
+                                             indexed_by<ordered_unique<tag<by_id>,
+                                                                       member<Object,
+                                                                              typename Object::id_type,
+                                                                              &Object::id>>>>
+        type;
+};
+
+template <typename Object> struct bench_index_type<Object, 1>
+{
+    typedef fc::shared_multi_index_container<Object,
+                                             indexed_by<ordered_unique<tag<by_id>,
+                                                                       member<Object,
+                                                                              typename Object::id_type,
+                                                                              &Object::id>>,
+                                                        ordered_unique<tag<by_key>,
+                                                                       member<Object, int64_t, &Object::key>>>>
+        type;
+};
+
+template <typename Object> struct bench_index_type<Object, 3>
+{
+    typedef fc::shared_multi_index_container<Object,
+                                             indexed_by<ordered_unique<tag<by_id>,
+                                                                       member<Object,
+                                                                              typename Object::id_type,
+                                                                              &Object::id>>,
+                                                        ordered_unique<tag<by_key>,
+                                                                       member<Object, int64_t, &Object::key>>,
+                                                        ordered_non_unique<tag<by_group>,
+                                                                           member<Object, int64_t, &Object::group>>,
+                                                        ordered_unique<tag<by_group_key>,
+                                                                       composite_key<Object,
+                                                                                     member<Object,
+                                                                                            int64_t,
+                                                                                            &Object::group>,
+                                                                                     member<Object,
+                                                                                            int64_t,
+                                                                                            &Object::key>>>>>
+        type;
+};
+}
+
+namespace chainbase {
+template <uint16_t TypeNumber, size_t PayloadSize, int SecondaryIndexes>
+struct get_index_type<chainbase_bench::bench_object<TypeNumber, PayloadSize, SecondaryIndexes>>
+{
+    typedef typename chainbase_bench::
+        bench_index_type<chainbase_bench::bench_object<TypeNumber, PayloadSize, SecondaryIndexes>,
+                         SecondaryIndexes>::type type;
+};
+}
+
+namespace chainbase_bench {
+
+const uint32_t random_seed = 20180701;
+const int64_t groups = 100;
+
+// the undo benchmarks register undo_object<first_undo_type> ... undo_object<first_undo_type + indexes - 1>
+const uint16_t first_undo_type = 100;
+
+template <uint16_t TypeNumber> using undo_object = bench_object<TypeNumber, 16, 0>;
+
+struct bench_options
+{
+    boost::filesystem::path dir;
+    uint32_t objects = 100000;
+    uint32_t sessions = 10000;
+    std::string filter;
+};
+
+bench_options options;
+
+// keeps the results of the lookups alive
+volatile int64_t sink = 0;
+
+class stopwatch
+{
+public:
+    void start()
+    {
+        _start = std::chrono::steady_clock::now();
+    }
+
+    void stop()
+    {
+        _elapsed += std::chrono::steady_clock::now() - _start;
+    }
+
+    std::chrono::nanoseconds elapsed() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(_elapsed);
+    }
+
+private:
+    std::chrono::steady_clock::time_point _start;
+    std::chrono::steady_clock::duration _elapsed = std::chrono::steady_clock::duration::zero();
+};
+
+void report(const std::string& name, uint64_t ops, const std::chrono::nanoseconds& elapsed)
+{
+    std::cout << std::left << std::setw(56) << name << std::right << std::setw(10) << ops << " ops"
+              << std::setw(14) << std::fixed << std::setprecision(1) << double(elapsed.count()) / std::max<uint64_t>(ops, 1)
+              << " ns/op" << std::endl;
+}
+
+template <typename Call> void measure(const std::string& name, uint64_t ops, Call&& call)
+{
+    stopwatch watch;
+    watch.start();
+    call();
+    watch.stop();
+    report(name, ops, watch.elapsed());
+}
+
+bool selected(const std::string& group)
+{
+    return options.filter.empty() || group.find(options.filter) != std::string::npos;
+}
+
+/**
+ * Database in its own directory that is removed with the database.
+ */
+class bench_database : public chainbase::database
+{
+public:
+    bench_database(uint64_t shared_file_size)
+        : _dir(options.dir / boost::filesystem::unique_path())
+    {
+        open(_dir, chainbase::database::read_write, shared_file_size);
+    }
+
+    ~bench_database()
+    {
+        wipe();
+        boost::filesystem::remove_all(_dir);
+    }
+
+    void undo()
+    {
+        for_each_index([](chainbase::abstract_generic_index_i& item) { item.undo(); });
+    }
+
+    void squash()
+    {
+        for_each_index([](chainbase::abstract_generic_index_i& item) { item.squash(); });
+    }
+
+    void commit()
+    {
+        for_each_index([](chainbase::abstract_generic_index_i& item) { item.commit(item.revision()); });
+    }
+
+private:
+    boost::filesystem::path _dir;
+};
+
+uint64_t shared_file_size(uint64_t objects, uint64_t object_size)
+{
+    // the nodes of the indexes and the copies kept by the undo state, the file is sparse
+    return 64ull * 1024 * 1024 + objects * (object_size + 256) * 4;
+}
+
+template <typename Object, int SecondaryIndexes = Object::secondary_indexes> struct key_lookups
+{
+    static void run(bench_database&, const std::string&, const std::vector<int64_t>&)
+    {
+    }
+};
+
+template <typename Object> struct key_lookups<Object, 1>
+{
+    static void run(bench_database& db, const std::string& group, const std::vector<int64_t>& keys)
+    {
+        measure(group + "/find_by_key", keys.size(), [&]() {
+            for (int64_t key : keys)
+                sink += db.get<Object, by_key>(key).group;
+        });
+    }
+};
+
+template <typename Object> struct key_lookups<Object, 3>
+{
+    static void run(bench_database& db, const std::string& group, const std::vector<int64_t>& keys)
+    {
+        key_lookups<Object, 1>::run(db, group, keys);
+
+        measure(group + "/find_by_composite_key", keys.size(), [&]() {
+            for (int64_t key : keys)
+                sink += db.get<Object, by_group_key>(boost::make_tuple(key % groups, key)).group;
+        });
+    }
+};
+
+/**
+ * emplace, lookups, modify and remove on an index with and without undo tracking
+ */
+template <typename Object> void run_object_benchmarks()
+{
+    typedef typename chainbase::get_index_type<Object>::type index_type;
+    typedef typename Object::id_type id_type;
+
+    const std::string group = "objects/payload:" + std::to_string(Object::payload_size) + "/secondary:"
+        + std::to_string(Object::secondary_indexes);
+    if (!selected(group))
+        return;
+
+    const uint32_t count = options.objects;
+
+    bench_database db(shared_file_size(count, sizeof(Object)));
+    db.add_index<index_type>();
+
+    // objects are created in id order with keys in random order, lookups and modifications go in random order
+    std::vector<int64_t> keys(count);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::mt19937 random(random_seed);
+    std::shuffle(keys.begin(), keys.end(), random);
+
+    auto create_objects = [&]() {
+        for (int64_t key : keys)
+        {
+            db.create<Object>([&](Object& o) {
+                o.key = key;
+                o.group = key % groups;
+                std::memset(o.payload, 0, sizeof(o.payload));
+            });
+        }
+    };
+
+    auto modify_objects = [&]() {
+        for (int64_t key : keys)
+        {
+            db.modify(db.get(id_type(key)), [&](Object& o) {
+                o.key += count;
+                o.group = (o.group + 1) % groups;
+                ++o.payload[0];
+            });
+        }
+    };
+
+    auto remove_objects = [&]() {
+        for (int64_t key : keys)
+            db.remove(db.get(id_type(key)));
+    };
+
+    measure(group + "/emplace", count, create_objects);
+
+    measure(group + "/find_by_id", count, [&]() {
+        for (int64_t key : keys)
+            sink += db.get(id_type(key)).key;
+    });
+
+    key_lookups<Object>::run(db, group, keys);
+
+    measure(group + "/modify", count, modify_objects);
+
+    auto session = db.start_undo_session();
+    measure(group + "/modify_in_session", count, modify_objects);
+    measure(group + "/undo_modifications", count, [&]() { session.reset(); });
+
+    session = db.start_undo_session();
+    measure(group + "/remove_in_session", count, remove_objects);
+    measure(group + "/undo_removals", count, [&]() { session.reset(); });
+
+    measure(group + "/remove", count, remove_objects);
+
+    session = db.start_undo_session();
+    measure(group + "/emplace_in_session", count, create_objects);
+    measure(group + "/undo_creations", count, [&]() { session.reset(); });
+}
+
+template <uint16_t First, uint16_t Count> struct undo_indexes
+{
+    static void add(bench_database& db)
+    {
+        db.add_index<typename chainbase::get_index_type<undo_object<First>>::type>();
+        undo_indexes<First + 1, Count - 1>::add(db);
+    }
+};
+
+template <uint16_t First> struct undo_indexes<First, 0>
+{
+    static void add(bench_database&)
+    {
+    }
+};
+
+/**
+ * Opens a database with the given number of registered indexes where every undo session modifies one object, as a
+ * block usually touches a small part of the indexes.
+ */
+template <uint16_t Indexes> class undo_database : public bench_database
+{
+public:
+    typedef undo_object<first_undo_type> object_type;
+
+    undo_database()
+        : bench_database(shared_file_size(options.sessions, sizeof(object_type)))
+    {
+        undo_indexes<first_undo_type, Indexes>::add(*this);
+
+        _object = &create<object_type>([](object_type& o) { std::memset(o.payload, 0, sizeof(o.payload)); });
+    }
+
+    void touch()
+    {
+        modify(*_object, [](object_type& o) { ++o.key; });
+    }
+
+private:
+    const object_type* _object = nullptr;
+};
+
+/**
+ * start_undo_session + undo (a failed transaction), start_undo_session + squash (an applied transaction inside of
+ * a block) and undo of pushed sessions (popped blocks)
+ */
+template <uint16_t Indexes> void run_undo_benchmarks()
+{
+    const std::string group = "undo/indexes:" + std::to_string(Indexes);
+    if (!selected(group))
+        return;
+
+    const uint32_t sessions = options.sessions;
+
+    undo_database<Indexes> db;
+
+    measure(group + "/session_undo", sessions, [&]() {
+        for (uint32_t i = 0; i < sessions; ++i)
+        {
+            auto session = db.start_undo_session();
+            db.touch();
+        }
+    });
+
+    auto block = db.start_undo_session();
+    measure(group + "/session_squash", sessions, [&]() {
+        for (uint32_t i = 0; i < sessions; ++i)
+        {
+            auto session = db.start_undo_session();
+            db.touch();
+            session->push();
+            db.squash();
+        }
+    });
+    block.reset();
+
+    for (uint32_t i = 0; i < sessions; ++i)
+    {
+        auto session = db.start_undo_session();
+        db.touch();
+        session->push();
+    }
+    measure(group + "/undo", sessions, [&]() {
+        for (uint32_t i = 0; i < sessions; ++i)
+            db.undo();
+    });
+}
+
+/**
+ * commit of the given number of pushed sessions, as done for the blocks that became irreversible
+ */
+void run_commit_benchmarks(uint32_t depth)
+{
+    static const uint16_t indexes = 32;
+
+    const std::string group = "commit/indexes:" + std::to_string(indexes) + "/depth:" + std::to_string(depth);
+    if (!selected(group))
+        return;
+
+    const uint32_t rounds = std::max<uint32_t>(options.sessions / depth, 1);
+
+    undo_database<indexes> db;
+
+    stopwatch watch;
+    for (uint32_t round = 0; round < rounds; ++round)
+    {
+        for (uint32_t i = 0; i < depth; ++i)
+        {
+            auto session = db.start_undo_session();
+            db.touch();
+            session->push();
+        }
+
+        watch.start();
+        db.commit();
+        watch.stop();
+    }
+
+    report(group + "/commit", rounds, watch.elapsed());
+}
+
+void parse_options(int argc, char** argv)
+{
+    static const std::string dir_arg = "--dir=";
+    static const std::string objects_arg = "--objects=";
+    static const std::string sessions_arg = "--sessions=";
+    static const std::string filter_arg = "--filter=";
+
+    options.dir = boost::filesystem::exists("/dev/shm") ? boost::filesystem::path("/dev/shm")
+                                                         : boost::filesystem::temp_directory_path();
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg.compare(0, dir_arg.size(), dir_arg) == 0)
+            options.dir = arg.substr(dir_arg.size());
+        else if (arg.compare(0, objects_arg.size(), objects_arg) == 0)
+            options.objects = std::max<uint32_t>(1u, std::stoul(arg.substr(objects_arg.size())));
+        else if (arg.compare(0, sessions_arg.size(), sessions_arg) == 0)
+            options.sessions = std::max<uint32_t>(1u, std::stoul(arg.substr(sessions_arg.size())));
+        else if (arg.compare(0, filter_arg.size(), filter_arg) == 0)
+            options.filter = arg.substr(filter_arg.size());
+        else
+            BOOST_THROW_EXCEPTION(std::invalid_argument("unknown argument " + arg));
+    }
+}
+}
+
+int main(int argc, char** argv)
+{
+    using namespace chainbase_bench;
+
+    try
+    {
+        parse_options(argc, argv);
+
+        std::cout << "shared memory files in " << options.dir.native() << std::endl;
+
+        run_object_benchmarks<bench_object<1, 16, 0>>();
+        run_object_benchmarks<bench_object<2, 16, 1>>();
+        run_object_benchmarks<bench_object<3, 16, 3>>();
+        run_object_benchmarks<bench_object<4, 256, 0>>();
+        run_object_benchmarks<bench_object<5, 256, 1>>();
+        run_object_benchmarks<bench_object<6, 256, 3>>();
+        run_object_benchmarks<bench_object<7, 1024, 0>>();
+        run_object_benchmarks<bench_object<8, 1024, 1>>();
+        run_object_benchmarks<bench_object<9, 1024, 3>>();
+
+        run_undo_benchmarks<1>();
+        run_undo_benchmarks<8>();
+        run_undo_benchmarks<32>();
+        run_undo_benchmarks<64>();
+
+        for (uint32_t depth : { 1u, 16u, 64u, 256u })
+            run_commit_benchmarks(depth);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
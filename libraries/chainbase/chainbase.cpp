@@ -1,10 +1,87 @@
 #include <chainbase/chainbase.hpp>
 
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #define SHARED_MEMORY_FILE "shared_memory.bin"
 #define SHARED_MEMORY_META_FILE "shared_memory.meta"
+#define SHARED_MEMORY_CHECKPOINT_FILE "shared_memory.checkpoint"
 
 namespace chainbase {
 
+namespace {
+
+segment_checkpoint make_checkpoint(uint64_t head, bool clean)
+{
+    segment_checkpoint checkpoint;
+    checkpoint.head = head;
+    checkpoint.clean = clean;
+    return checkpoint;
+}
+
+boost::optional<segment_checkpoint> read_checkpoint(const boost::filesystem::path& file)
+{
+    std::ifstream in(file.generic_string());
+
+    segment_checkpoint checkpoint;
+    std::string state;
+    if (!(in >> checkpoint.head >> state))
+        return boost::optional<segment_checkpoint>();
+
+    checkpoint.clean = (state == "clean");
+    return checkpoint;
+}
+
+#ifndef WIN32
+void sync_path(const boost::filesystem::path& path, int flags)
+{
+    const int fd = ::open(path.c_str(), flags);
+    if (fd < 0)
+        BOOST_THROW_EXCEPTION(std::runtime_error("could not open " + path.generic_string() + ": " + strerror(errno)));
+
+    const int result = ::fsync(fd);
+    const int error = errno;
+    ::close(fd);
+
+    if (result != 0)
+        BOOST_THROW_EXCEPTION(std::runtime_error("could not sync " + path.generic_string() + ": " + strerror(error)));
+}
+#endif
+
+void write_checkpoint(const boost::filesystem::path& file, const segment_checkpoint& checkpoint)
+{
+    // the marker is replaced by rename, so a crash leaves the old or the new marker: the new one is on disk before the
+    // rename and the directory entry is on disk after it
+    boost::filesystem::path temp_file = file;
+    temp_file += ".tmp";
+
+    {
+        std::ofstream out(temp_file.generic_string(), std::ios::trunc);
+        out << checkpoint.head << ' ' << (checkpoint.clean ? "clean" : "dirty") << '\n';
+        out.flush();
+
+        if (!out)
+            BOOST_THROW_EXCEPTION(std::runtime_error("could not write checkpoint to " + temp_file.generic_string()));
+    }
+
+#ifndef WIN32
+    sync_path(temp_file, O_WRONLY);
+#endif
+
+    boost::filesystem::rename(temp_file, file);
+
+#ifndef WIN32
+    sync_path(file.has_parent_path() ? file.parent_path() : boost::filesystem::path("."), O_RDONLY | O_DIRECTORY);
+#endif
+}
+}
+
 database::~database()
 {
 }
@@ -50,7 +127,10 @@ void database::open(const boost::filesystem::path& dir, uint32_t flags, uint64_t
 
     _data_dir = dir;
 
-    create_segment_file(boost::filesystem::absolute(dir / SHARED_MEMORY_FILE), read_only, shared_file_size);
+    const boost::filesystem::path segment_file = boost::filesystem::absolute(dir / SHARED_MEMORY_FILE);
+    const bool new_segment = !boost::filesystem::exists(segment_file);
+
+    create_segment_file(segment_file, read_only, shared_file_size);
 
     create_meta_file(boost::filesystem::absolute(dir / SHARED_MEMORY_META_FILE));
 
@@ -61,6 +141,22 @@ void database::open(const boost::filesystem::path& dir, uint32_t flags, uint64_t
         if (!_flock.try_lock())
             BOOST_THROW_EXCEPTION(std::runtime_error("could not gain write access to the shared memory file"));
     }
+
+    open_checkpoint(boost::filesystem::absolute(dir / SHARED_MEMORY_CHECKPOINT_FILE), new_segment && !read_only);
+
+    // the file is going to be changed, it is not a clean image any more
+    if (!read_only)
+        write_checkpoint(dir / SHARED_MEMORY_CHECKPOINT_FILE,
+                         make_checkpoint(_opened_checkpoint ? _opened_checkpoint->head : 0, false));
+}
+
+void database::open_checkpoint(const boost::filesystem::path& file, bool new_segment)
+{
+    // the marker of a removed segment file does not describe the new one
+    if (new_segment)
+        boost::filesystem::remove(file);
+
+    _opened_checkpoint = read_checkpoint(file);
 }
 
 void database::flush()
@@ -71,6 +167,111 @@ void database::flush()
         _meta->flush();
 }
 
+bool database::flush_in_background(uint64_t head)
+{
+    const boost::filesystem::path file = _data_dir / SHARED_MEMORY_CHECKPOINT_FILE;
+
+    return flush_segment_file_in_background([file, head]() { write_checkpoint(file, make_checkpoint(head, false)); });
+}
+
+void database::checkpoint(uint64_t head)
+{
+    stop_background_flush();
+
+    sync_segment_file();
+    if (_meta)
+        _meta->flush();
+
+    write_checkpoint(_data_dir / SHARED_MEMORY_CHECKPOINT_FILE, make_checkpoint(head, true));
+}
+
+void database::grow(uint64_t increment)
+{
+    if (!_segment || _read_only)
+        BOOST_THROW_EXCEPTION(std::runtime_error("could not grow the shared memory file that is not open for writing"));
+
+    if (active_undo_sessions() != 0)
+        BOOST_THROW_EXCEPTION(std::runtime_error("could not grow the shared memory file while undo session is active"));
+
+    const char* old_address = static_cast<const char*>(_segment->get_address());
+
+    const bool grown = grow_segment_file(increment);
+
+    relocate_indexes(old_address, static_cast<char*>(_segment->get_address()));
+
+    if (!grown)
+        BOOST_THROW_EXCEPTION(std::runtime_error("could not grow the shared memory file"));
+}
+
+void database::compact(uint64_t shared_file_size)
+{
+    if (!_segment || _read_only)
+        BOOST_THROW_EXCEPTION(
+            std::runtime_error("could not compact the shared memory file that is not open for writing"));
+
+    if (active_undo_sessions() != 0)
+        BOOST_THROW_EXCEPTION(
+            std::runtime_error("could not compact the shared memory file while undo session is active"));
+
+    boost::filesystem::path compacted_file = boost::filesystem::absolute(_data_dir / SHARED_MEMORY_FILE);
+    compacted_file += ".compacted";
+    boost::filesystem::remove(compacted_file);
+
+    boost::container::flat_map<uint16_t, size_t> offsets;
+
+    try
+    {
+        copy_segment_file(compacted_file, shared_file_size, [&](boost::interprocess::managed_mapped_file& segment) {
+            for (const auto& item : _index_map)
+            {
+                const abstract_generic_index_i* index = static_cast<const abstract_generic_index_i*>(item.second);
+
+                const size_t free = segment.get_free_memory();
+                const char* copy = static_cast<const char*>(index->copy_to(segment));
+
+                offsets[item.first] = copy - static_cast<const char*>(segment.get_address());
+
+                const index_memory_stats stats = index->get_memory_stats();
+                ilog("Compacted ${i}: ${n} objects in ${s}K",
+                     ("i", stats.name)("n", stats.objects)("s", (free - segment.get_free_memory()) / 1024));
+            }
+        });
+    }
+    catch (...)
+    {
+        boost::filesystem::remove(compacted_file);
+        throw;
+    }
+
+    const char* old_address = static_cast<const char*>(_segment->get_address());
+
+    if (!replace_segment_file(compacted_file))
+    {
+        relocate_indexes(old_address, static_cast<char*>(_segment->get_address()));
+        boost::filesystem::remove(compacted_file);
+
+        BOOST_THROW_EXCEPTION(std::runtime_error("could not replace the shared memory file by the compacted one"));
+    }
+
+    rebind_indexes(static_cast<char*>(_segment->get_address()), offsets);
+}
+
+std::vector<index_memory_stats> database::get_index_memory_stats() const
+{
+    std::vector<index_memory_stats> result;
+    result.reserve(_index_map.size());
+
+    for (const auto& item : _index_map)
+        result.push_back(static_cast<const abstract_generic_index_i*>(item.second)->get_memory_stats());
+
+    return result;
+}
+
+const boost::optional<segment_checkpoint>& database::get_opened_checkpoint() const
+{
+    return _opened_checkpoint;
+}
+
 void database::close()
 {
     close_segment_file();
@@ -85,7 +286,9 @@ void database::wipe()
     close();
     boost::filesystem::remove_all(dir / SHARED_MEMORY_FILE);
     boost::filesystem::remove_all(dir / SHARED_MEMORY_META_FILE);
+    boost::filesystem::remove_all(dir / SHARED_MEMORY_CHECKPOINT_FILE);
     _index_map.clear();
+    _index_slots.clear();
 }
 
 } // namespace chainbase
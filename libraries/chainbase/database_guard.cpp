@@ -30,6 +30,11 @@ uint32_t read_write_mutex_manager::current_lock_num()
     return _current_lock;
 }
 
+read_write_mutex& read_write_mutex_manager::get_lock(uint32_t num)
+{
+    return _locks[num % CHAINBASE_NUM_RW_LOCKS];
+}
+
 //////////////////////////////////////////////////////////////////////////
 database_guard::~database_guard()
 {
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 #include <boost/cstdint.hpp>
+#include <boost/interprocess/managed_mapped_file.hpp>
 
 namespace chainbase {
 
@@ -16,6 +18,27 @@ struct abstract_undo_session
 using abstract_undo_session_ptr = std::unique_ptr<abstract_undo_session>;
 using abstract_undo_session_list = std::vector<abstract_undo_session_ptr>;
 
+/**
+ * Memory taken by an index. Members of the objects that allocate memory of their own (strings, vectors) are not
+ * counted, so the size is the lower bound.
+ */
+struct index_memory_stats
+{
+    std::string name;
+
+    uint64_t objects = 0;
+
+    /// bytes of a node of the container: the object and the links of all of its orderings
+    uint64_t node_size = 0;
+
+    uint64_t undo_sessions = 0;
+
+    /// copies of modified and removed objects kept by the undo sessions
+    uint64_t undo_values = 0;
+
+    uint64_t size = 0;
+};
+
 //------------------------------------------------------------------------------------------------------//
 struct abstract_generic_index_i
 {
@@ -30,5 +53,10 @@ struct abstract_generic_index_i
     virtual void undo_all() = 0;
     virtual void squash() = 0;
     virtual void commit(int64_t revision) = 0;
+
+    virtual index_memory_stats get_memory_stats() const = 0;
+
+    /// constructs a copy of the index with all its objects in another segment, the index should have no undo state
+    virtual void* copy_to(boost::interprocess::managed_mapped_file& segment) const = 0;
 };
 }
@@ -2,11 +2,28 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/optional.hpp>
 
 #include <chainbase/undo_db_state.hpp>
 
 namespace chainbase {
 
+/**
+ * Marker of the image of the shared memory file on disk, it is kept in a file next to the shared memory file
+ */
+struct segment_checkpoint
+{
+    /**
+     * Position of the owner of the database (e.g. the head block) when the flush started, all changes made before it
+     * are on disk. A background flush also writes pages that later positions change while it runs, so unless the file
+     * is clean the image on disk is a mix of head and later changes and matches no single position.
+     */
+    uint64_t head = 0;
+
+    /// the file was synced as a whole on close, nothing was changed after head
+    bool clean = false;
+};
+
 class database : public undo_db_state
 {
     boost::interprocess::file_lock _flock;
@@ -15,9 +32,12 @@ class database : public undo_db_state
 
     std::unique_ptr<boost::interprocess::managed_mapped_file> _meta;
 
+    boost::optional<segment_checkpoint> _opened_checkpoint;
+
 private:
     void check_dir_existance(const boost::filesystem::path& dir, bool read_only);
     void create_meta_file(const boost::filesystem::path& file);
+    void open_checkpoint(const boost::filesystem::path& file, bool new_segment);
 
 public:
     virtual ~database();
@@ -32,6 +52,36 @@ public:
     void close();
     void flush();
     void wipe();
+
+    /**
+     * Flushes the file on a background thread, head is written to the checkpoint marker when the flush is complete.
+     * The image on disk is not consistent with any head, see segment_checkpoint. Returns false if the previous flush
+     * is still running.
+     */
+    bool flush_in_background(uint64_t head);
+
+    /// flushes the file and marks it as a clean image of head, it should be the last change before close
+    void checkpoint(uint64_t head);
+
+    /**
+     * Grows the shared memory file by increment bytes without closing the database. The file is mapped again, so no
+     * undo session may be active and references to objects are not valid any more. Readers must be kept out by
+     * with_all_locks() on an open database.
+     */
+    void grow(uint64_t increment);
+
+    /**
+     * Copies the indexes into a fresh shared memory file of shared_file_size bytes and replaces the file by it. The
+     * objects are allocated one after another, so the holes left by removed objects are reclaimed. No undo state may
+     * be kept and references to objects are not valid any more.
+     */
+    void compact(uint64_t shared_file_size);
+
+    /// memory taken by the indexes in type_id order
+    std::vector<index_memory_stats> get_index_memory_stats() const;
+
+    /// checkpoint marker found on open, it is empty for a new file
+    const boost::optional<segment_checkpoint>& get_opened_checkpoint() const;
 };
 
 } // namespace chainbase
@@ -2,7 +2,10 @@
 
 #include <atomic>
 #include <array>
+#include <memory>
+#include <mutex>
 #include <typeinfo>
+#include <vector>
 
 #include <boost/interprocess/sync/interprocess_sharable_mutex.hpp>
 #include <boost/interprocess/sync/sharable_lock.hpp>
@@ -15,8 +18,14 @@
 #define CHAINBASE_NUM_RW_LOCKS 10
 #endif
 
+// The lock requirements are checked in every index access, builds without CHAINBASE_CHECK_LOCKS compile them out
+#ifdef CHAINBASE_CHECK_LOCKS
 #define CHAINBASE_REQUIRE_READ_LOCK(t) require_read_lock(__FUNCTION__, typeid(t).name())
 #define CHAINBASE_REQUIRE_WRITE_LOCK(t) require_write_lock(__FUNCTION__, typeid(t).name())
+#else
+#define CHAINBASE_REQUIRE_READ_LOCK(t)
+#define CHAINBASE_REQUIRE_WRITE_LOCK(t)
+#endif
 
 namespace chainbase {
 
@@ -34,6 +43,7 @@ public:
     void next_lock();
     read_write_mutex& current_lock();
     uint32_t current_lock_num();
+    read_write_mutex& get_lock(uint32_t num);
 
 private:
     std::array<read_write_mutex, CHAINBASE_NUM_RW_LOCKS> _locks;
@@ -50,6 +60,30 @@ protected:
     int32_t _write_lock_count = 0;
     bool _enable_require_locking = false;
 
+    /// the lock held by the writer, with_all_locks() takes the others
+    read_write_mutex* _write_mutex = nullptr;
+
+    /// the locks are not rotated while with_all_locks() holds them
+    std::mutex _rotation_mutex;
+
+    struct write_mutex_scope
+    {
+        write_mutex_scope(read_write_mutex*& write_mutex, read_write_mutex* mutex)
+            : _write_mutex(write_mutex)
+            , _outer(write_mutex)
+        {
+            _write_mutex = mutex;
+        }
+
+        ~write_mutex_scope()
+        {
+            _write_mutex = _outer;
+        }
+
+        read_write_mutex*& _write_mutex;
+        read_write_mutex* _outer;
+    };
+
 public:
     virtual ~database_guard();
 
@@ -105,12 +139,42 @@ public:
             while (!lock.timed_lock(boost::posix_time::microsec_clock::universal_time()
                                     + boost::posix_time::microseconds(wait_micro)))
             {
+                std::lock_guard<std::mutex> rotation(_rotation_mutex);
                 _rw_manager->next_lock();
                 std::cerr << "Lock timeout, moving to lock " << _rw_manager->current_lock_num() << std::endl;
                 lock = write_lock(_rw_manager->current_lock(), boost::defer_lock_t());
             }
         }
 
+        write_mutex_scope scope(_write_mutex, lock.mutex());
+
+        return callback();
+    }
+
+    /**
+     * Calls the callback holding every lock of the manager, must be called under the write lock. A writer that timed
+     * out moves readers to the next lock while readers of the previous ones may still run, so only all of the locks
+     * keep every reader out. The locks are not rotated until the callback returns.
+     *
+     * Needed by changes that move the memory the readers use (see chainbase::database::grow).
+     */
+    template <typename Lambda> auto with_all_locks(Lambda&& callback) -> decltype((*(Lambda*)nullptr)())
+    {
+        FC_ASSERT(_rw_manager);
+        FC_ASSERT(_write_mutex != nullptr, "all locks can be taken under the write lock only");
+
+        std::lock_guard<std::mutex> rotation(_rotation_mutex);
+
+        std::vector<std::unique_ptr<write_lock>> locks;
+        locks.reserve(CHAINBASE_NUM_RW_LOCKS);
+
+        for (uint32_t num = 0; num < CHAINBASE_NUM_RW_LOCKS; ++num)
+        {
+            read_write_mutex& mutex = _rw_manager->get_lock(num);
+            if (&mutex != _write_mutex)
+                locks.emplace_back(new write_lock(mutex));
+        }
+
         return callback();
     }
 };
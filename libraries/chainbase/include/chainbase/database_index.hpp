@@ -1,7 +1,10 @@
 #pragma once
 
+#include <boost/config.hpp>
 #include <boost/container/flat_map.hpp>
 
+#include <vector>
+
 #include <chainbase/chain_object.hpp>
 #include <chainbase/database_guard.hpp>
 #include <chainbase/generic_index.hpp>
@@ -37,6 +40,10 @@ public:
 
         _index_map[type_id] = idx_ptr;
 
+        if (_index_slots.size() <= size_t(type_id))
+            _index_slots.resize(type_id + 1u, nullptr);
+        _index_slots[type_id] = idx_ptr;
+
         return *idx_ptr;
     }
 
@@ -44,22 +51,15 @@ public:
     {
         CHAINBASE_REQUIRE_READ_LOCK(typename MultiIndexType::value_type);
         typedef generic_index<MultiIndexType> index_type;
-        return _index_map.find((uint16_t)index_type::value_type::type_id) != _index_map.end();
+        return index_slot(index_type::value_type::type_id) != nullptr;
     }
 
     template <typename MultiIndexType> const generic_index<MultiIndexType>& get_index() const
     {
         CHAINBASE_REQUIRE_READ_LOCK(typename MultiIndexType::value_type);
         typedef generic_index<MultiIndexType> index_type;
-        typedef index_type* index_type_ptr;
 
-        if (!has_index<MultiIndexType>())
-        {
-            std::string type_name = boost::core::demangle(typeid(typename index_type::value_type).name());
-            BOOST_THROW_EXCEPTION(std::runtime_error("unable to find index for " + type_name + " in database"));
-        }
-
-        return *index_type_ptr(_index_map.find((uint16_t)index_type::value_type::type_id)->second);
+        return *static_cast<index_type*>(require_index_slot<index_type>());
     }
 
     template <typename MultiIndexType, typename ByIndex>
@@ -67,32 +67,16 @@ public:
     {
         CHAINBASE_REQUIRE_READ_LOCK(typename MultiIndexType::value_type);
         typedef generic_index<MultiIndexType> index_type;
-        typedef index_type* index_type_ptr;
-
-        if (!has_index<MultiIndexType>())
-        {
-            std::string type_name = boost::core::demangle(typeid(typename index_type::value_type).name());
-            BOOST_THROW_EXCEPTION(std::runtime_error("unable to find index for " + type_name + " in database"));
-        }
 
-        return index_type_ptr(_index_map.find((uint16_t)index_type::value_type::type_id)->second)
-            ->indices()
-            .template get<ByIndex>();
+        return static_cast<index_type*>(require_index_slot<index_type>())->indices().template get<ByIndex>();
     }
 
     template <typename MultiIndexType> generic_index<MultiIndexType>& get_mutable_index()
     {
         CHAINBASE_REQUIRE_WRITE_LOCK(typename MultiIndexType::value_type);
         typedef generic_index<MultiIndexType> index_type;
-        typedef index_type* index_type_ptr;
-
-        if (!has_index<MultiIndexType>())
-        {
-            std::string type_name = boost::core::demangle(typeid(typename index_type::value_type).name());
-            BOOST_THROW_EXCEPTION(std::runtime_error("unable to find index for " + type_name + " in database"));
-        }
 
-        return *index_type_ptr(_index_map.find((uint16_t)index_type::value_type::type_id)->second);
+        return *static_cast<index_type*>(require_index_slot<index_type>());
     }
 
     template <typename ObjectType, typename IndexedByType, typename CompatibleKey>
@@ -168,8 +152,59 @@ public:
 
 protected:
     /**
-    * This is a full map (size 2^16) of all possible index designed for constant time lookup
+    * Moves the pointers to the indexes after the segment is mapped to another address, the indexes keep their offsets
+    * in the segment
+    */
+    void relocate_indexes(const char* old_address, char* new_address)
+    {
+        for (auto& item : _index_map)
+            item.second = new_address + (static_cast<const char*>(item.second) - old_address);
+
+        for (void*& slot : _index_slots)
+        {
+            if (slot)
+                slot = new_address + (static_cast<const char*>(slot) - old_address);
+        }
+    }
+
+    /**
+    * Points the indexes to their copies in another segment mapped at address, offsets of the copies are by type_id
+    */
+    void rebind_indexes(char* address, const boost::container::flat_map<uint16_t, size_t>& offsets)
+    {
+        for (auto& item : _index_map)
+        {
+            item.second = address + offsets.at(item.first);
+            _index_slots[item.first] = item.second;
+        }
+    }
+
+    /**
+    * All indexes by type_id, used to walk over the indexes in type_id order
     */
     boost::container::flat_map<uint16_t, void*> _index_map;
+
+    /**
+    * The same indexes in a dense array addressed by type_id, the slot of an index is set by add_index so the typed
+    * accessors above find it in constant time without a lookup in _index_map
+    */
+    std::vector<void*> _index_slots;
+
+private:
+    void* index_slot(uint16_t type_id) const
+    {
+        return size_t(type_id) < _index_slots.size() ? _index_slots[type_id] : nullptr;
+    }
+
+    template <typename IndexType> void* require_index_slot() const
+    {
+        void* idx_ptr = index_slot(IndexType::value_type::type_id);
+        if (BOOST_UNLIKELY(idx_ptr == nullptr))
+        {
+            std::string type_name = boost::core::demangle(typeid(typename IndexType::value_type).name());
+            BOOST_THROW_EXCEPTION(std::runtime_error("unable to find index for " + type_name + " in database"));
+        }
+        return idx_ptr;
+    }
 };
 }
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <boost/core/demangle.hpp>
 #include <boost/throw_exception.hpp>
 #include <stdexcept>
+#include <typeinfo>
 
 #include <fc/shared_containers.hpp>
 
@@ -372,6 +374,42 @@ private:
         return _revision;
     }
 
+    index_memory_stats get_memory_stats() const override
+    {
+        index_memory_stats stats;
+        stats.name = boost::core::demangle(typeid(value_type).name());
+        stats.objects = this->_indices.size();
+        stats.node_size = sizeof(typename MultiIndexType::node_type);
+        stats.undo_sessions = _stack.size();
+
+        for (const auto& state : _stack)
+            stats.undo_values += state.old_values.size() + state.removed_values.size();
+
+        stats.size = stats.objects * stats.node_size + stats.undo_values * sizeof(value_type);
+
+        return stats;
+    }
+
+    void* copy_to(boost::interprocess::managed_mapped_file& segment) const override
+    {
+        if (enabled())
+            BOOST_THROW_EXCEPTION(std::logic_error("cannot copy index with undo state"));
+
+        const std::string type_name = boost::core::demangle(typeid(value_type).name());
+
+        generic_index* copy = segment.construct<generic_index>(type_name.c_str())(segment.get_segment_manager());
+
+        // objects are copied in id order, so they are allocated one after another in the new segment. They are
+        // constructed with the allocator of the new segment and assigned, so their containers keep that allocator
+        for (const value_type& value : this->_indices)
+            copy->emplace_([&](value_type& v) { v = value; }, copy->get_allocator());
+
+        copy->_next_id = this->_next_id;
+        copy->_revision = _revision;
+
+        return copy;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     bool enabled() const
     {
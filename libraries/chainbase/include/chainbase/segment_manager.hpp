@@ -4,8 +4,73 @@
 
 #include <chainbase/generic_index.hpp>
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace chainbase {
 
+/**
+ * How the segment file is mapped. All of them are hints: a system that does not support one logs it and maps the file
+ * as usual.
+ */
+struct segment_mapping_options
+{
+    enum access_hint
+    {
+        normal_access,
+        random_access,
+        sequential_access,
+        willneed_access
+    };
+
+    /// asks for transparent huge pages, the kernel uses them for files on tmpfs (e.g. /dev/shm) only
+    bool huge_pages = false;
+
+    /// reads every page of the file on open, so block application does not wait for cold page faults
+    bool prefault = false;
+
+    access_hint access = normal_access;
+};
+
+struct segment_stats
+{
+    uint64_t size = 0;
+    uint64_t free = 0;
+
+    /// bytes of the file that are in memory
+    uint64_t resident = 0;
+
+    /// page faults of the process
+    uint64_t minor_faults = 0;
+    uint64_t major_faults = 0;
+};
+
+struct segment_free_block_bucket
+{
+    /// the blocks of the bucket are of [min_size, 2 * min_size) bytes
+    uint64_t min_size = 0;
+
+    uint64_t blocks = 0;
+    uint64_t bytes = 0;
+};
+
+/**
+ * Free blocks of the allocator of the segment. The free memory is fragmented when it is split into many small blocks,
+ * the largest block is the biggest object that can be allocated.
+ */
+struct segment_free_blocks
+{
+    uint64_t free = 0;
+    uint64_t blocks = 0;
+    uint64_t largest = 0;
+
+    /// the buckets that have blocks, by size
+    std::vector<segment_free_block_bucket> histogram;
+};
+
 class segment_manager
 {
 protected:
@@ -13,13 +78,67 @@ protected:
 
     std::unique_ptr<boost::interprocess::managed_mapped_file> _segment;
 
+    segment_mapping_options _mapping_options;
+
+public:
+    virtual ~segment_manager();
+
+    /// takes effect on the next open
+    void set_mapping_options(const segment_mapping_options& options);
+
+    /// the resident size is counted page by page, it is not for every block
+    segment_stats get_segment_stats() const;
+
+    /**
+     * The allocator does not expose its free blocks, they are counted by allocating each of them and released after.
+     * The segment file should be opened for writing and nothing else may allocate in it meanwhile, so it is not for
+     * a running node: the free memory is taken from block application while the blocks are counted.
+     */
+    segment_free_blocks get_segment_free_blocks();
+
 protected:
     size_t get_free_memory() const;
 
     void create_segment_file(const boost::filesystem::path& file, bool read_only, uint64_t shared_file_size);
 
+    void apply_mapping_options(bool prefault);
+
+    /**
+     * Grows the file by increment bytes and maps it again, the segment may be mapped to another address. The file is
+     * mapped again even if it could not be grown, then false is returned.
+     */
+    bool grow_segment_file(uint64_t increment);
+
+    /**
+     * Creates another segment file of shared_file_size bytes and lets copy fill it, the file is synced to disk and
+     * closed then.
+     */
+    void copy_segment_file(const boost::filesystem::path& file,
+                           uint64_t shared_file_size,
+                           const std::function<void(boost::interprocess::managed_mapped_file&)>& copy);
+
+    /**
+     * Renames file over the segment file and maps it. The segment file is mapped again if it could not be replaced,
+     * then false is returned.
+     */
+    bool replace_segment_file(const boost::filesystem::path& file);
+
     void flush_segment_file();
 
+    /// flushes the file and waits until it is on disk
+    void sync_segment_file();
+
+    /**
+     * Syncs the file to disk chunk by chunk on a background thread, so the owner of the segment is not blocked. done is
+     * called on that thread when every chunk is synced.
+     *
+     * Returns false if the previous background flush is still running.
+     */
+    bool flush_segment_file_in_background(std::function<void()>&& done);
+
+    /// interrupts the background flush and waits for its thread, done is not called for an interrupted flush
+    void stop_background_flush();
+
     void close_segment_file();
 
     template <typename index_type> index_type* allocate_index()
@@ -43,5 +162,14 @@ protected:
 
         return idx_ptr;
     }
+
+private:
+    boost::filesystem::path _segment_file;
+
+    std::thread _flush_thread;
+    std::atomic<bool> _flushing{ false };
+    std::atomic<bool> _stop_flushing{ false };
+
+    std::mutex _free_blocks_mutex;
 };
 }
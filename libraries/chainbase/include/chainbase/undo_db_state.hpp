@@ -19,5 +19,14 @@ public:
     }
 
     abstract_undo_session_ptr start_undo_session();
+
+    /// sessions started by start_undo_session that are not destroyed yet
+    size_t active_undo_sessions() const
+    {
+        return _active_undo_sessions;
+    }
+
+private:
+    size_t _active_undo_sessions = 0;
 };
 }
@@ -1,8 +1,21 @@
 #include <boost/array.hpp>
+#include <boost/core/ignore_unused.hpp>
 #include <boost/filesystem.hpp>
 #include <fc/exception/exception.hpp>
+#include <fc/time.hpp>
 #include <chainbase/segment_manager.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
 namespace chainbase {
 
 struct environment_check
@@ -39,12 +52,19 @@ struct environment_check
 
 //////////////////////////////////////////////////////////////////////////
 
+segment_manager::~segment_manager()
+{
+    stop_background_flush();
+}
+
 void segment_manager::create_segment_file(const boost::filesystem::path& file,
                                           bool read_only,
                                           uint64_t shared_file_size)
 {
     ilog("Try to open segment file");
 
+    stop_background_flush();
+
     if (boost::filesystem::exists(file))
     {
         if (read_only)
@@ -81,6 +101,136 @@ void segment_manager::create_segment_file(const boost::filesystem::path& file,
                                                                     file.generic_string().c_str(), shared_file_size));
         _segment->construct<environment_check>("environment")();
     }
+
+    _segment_file = file;
+
+    apply_mapping_options(_mapping_options.prefault);
+}
+
+bool segment_manager::grow_segment_file(uint64_t increment)
+{
+    FC_ASSERT(_segment && !_read_only, "Only the segment file opened for writing can be grown.");
+
+    stop_background_flush();
+
+    const std::string file = _segment_file.generic_string();
+
+    _segment.reset();
+
+    const bool grown = boost::interprocess::managed_mapped_file::grow(file.c_str(), increment);
+
+    _segment.reset(new boost::interprocess::managed_mapped_file(boost::interprocess::open_only, file.c_str()));
+
+    // the pages are in memory already, they are not read again
+    apply_mapping_options(false);
+
+    return grown;
+}
+
+void segment_manager::copy_segment_file(const boost::filesystem::path& file,
+                                        uint64_t shared_file_size,
+                                        const std::function<void(boost::interprocess::managed_mapped_file&)>& copy)
+{
+    boost::interprocess::managed_mapped_file segment(boost::interprocess::create_only, file.generic_string().c_str(),
+                                                     shared_file_size);
+    segment.construct<environment_check>("environment")();
+
+    copy(segment);
+
+#ifndef WIN32
+    if (msync(segment.get_address(), segment.get_size(), MS_SYNC) != 0)
+        BOOST_THROW_EXCEPTION(std::runtime_error(std::string("could not sync the segment file: ") + strerror(errno)));
+#else
+    segment.flush();
+#endif
+}
+
+bool segment_manager::replace_segment_file(const boost::filesystem::path& file)
+{
+    FC_ASSERT(_segment && !_read_only, "Only the segment file opened for writing can be replaced.");
+
+    stop_background_flush();
+
+    _segment.reset();
+
+    bool replaced = true;
+    try
+    {
+        boost::filesystem::rename(file, _segment_file);
+    }
+    catch (const boost::filesystem::filesystem_error& e)
+    {
+        wlog("Could not replace the segment file: ${e}", ("e", e.what()));
+        replaced = false;
+    }
+
+    _segment.reset(new boost::interprocess::managed_mapped_file(boost::interprocess::open_only,
+                                                                _segment_file.generic_string().c_str()));
+
+    apply_mapping_options(replaced && _mapping_options.prefault);
+
+    return replaced;
+}
+
+void segment_manager::set_mapping_options(const segment_mapping_options& options)
+{
+    _mapping_options = options;
+}
+
+void segment_manager::apply_mapping_options(bool prefault)
+{
+#ifndef WIN32
+    char* address = static_cast<char*>(_segment->get_address());
+    const size_t size = _segment->get_size();
+
+    if (_mapping_options.huge_pages)
+    {
+#ifdef MADV_HUGEPAGE
+        if (madvise(address, size, MADV_HUGEPAGE) != 0)
+            wlog("Could not use huge pages for the segment file: ${e}", ("e", strerror(errno)));
+#else
+        wlog("Huge pages are not supported by the system");
+#endif
+    }
+
+    int advice = MADV_NORMAL;
+    switch (_mapping_options.access)
+    {
+    case segment_mapping_options::random_access:
+        advice = MADV_RANDOM;
+        break;
+    case segment_mapping_options::sequential_access:
+        advice = MADV_SEQUENTIAL;
+        break;
+    case segment_mapping_options::willneed_access:
+        advice = MADV_WILLNEED;
+        break;
+    default:
+        break;
+    }
+
+    if (advice != MADV_NORMAL && madvise(address, size, advice) != 0)
+        wlog("Could not set the access hint for the segment file: ${e}", ("e", strerror(errno)));
+
+    if (prefault)
+    {
+        ilog("Prefaulting ${n}M of the segment file", ("n", size / (1024 * 1024)));
+
+        const fc::time_point start = fc::time_point::now();
+        const size_t page_size = sysconf(_SC_PAGESIZE);
+        const volatile char* pages = address;
+
+        char sum = 0;
+        for (size_t offset = 0; offset < size; offset += page_size)
+            sum ^= pages[offset];
+        boost::ignore_unused(sum);
+
+        ilog("Segment file is prefaulted in ${t} ms", ("t", (fc::time_point::now() - start).count() / 1000));
+    }
+#else
+    if (_mapping_options.huge_pages || prefault || _mapping_options.access != segment_mapping_options::normal_access)
+        wlog("Segment mapping options are not supported by the system");
+#endif
 }
 
 void segment_manager::flush_segment_file()
@@ -89,8 +239,83 @@ void segment_manager::flush_segment_file()
     _segment->flush();
 }
 
+void segment_manager::sync_segment_file()
+{
+    FC_ASSERT(_segment);
+
+#ifndef WIN32
+    if (msync(_segment->get_address(), _segment->get_size(), MS_SYNC) != 0)
+        BOOST_THROW_EXCEPTION(std::runtime_error(std::string("could not sync the segment file: ") + strerror(errno)));
+#else
+    _segment->flush();
+#endif
+}
+
+bool segment_manager::flush_segment_file_in_background(std::function<void()>&& done)
+{
+    FC_ASSERT(_segment);
+
+    if (_flushing)
+        return false;
+
+    if (_flush_thread.joinable())
+        _flush_thread.join();
+
+    _flushing = true;
+    _stop_flushing = false;
+
+    char* address = static_cast<char*>(_segment->get_address());
+    const size_t size = _segment->get_size();
+
+    _flush_thread = std::thread([this, address, size, done]() {
+#ifndef WIN32
+        // small chunks keep the pages the node writes to from waiting for the writeback of the whole file
+        const size_t chunk_size = 16 * 1024 * 1024;
+
+        for (size_t offset = 0; offset < size && !_stop_flushing; offset += chunk_size)
+        {
+            if (msync(address + offset, std::min(chunk_size, size - offset), MS_SYNC) != 0)
+            {
+                wlog("Could not flush the segment file: ${e}", ("e", strerror(errno)));
+                _stop_flushing = true;
+            }
+        }
+#else
+        boost::ignore_unused(address, size);
+        _segment->flush();
+#endif
+
+        try
+        {
+            if (!_stop_flushing)
+                done();
+        }
+        catch (const fc::exception& e)
+        {
+            elog("Could not complete the flush of the segment file: ${e}", ("e", e.to_detail_string()));
+        }
+        catch (const std::exception& e)
+        {
+            elog("Could not complete the flush of the segment file: ${e}", ("e", e.what()));
+        }
+
+        _flushing = false;
+    });
+
+    return true;
+}
+
+void segment_manager::stop_background_flush()
+{
+    _stop_flushing = true;
+
+    if (_flush_thread.joinable())
+        _flush_thread.join();
+}
+
 void segment_manager::close_segment_file()
 {
+    stop_background_flush();
     _segment.reset();
 }
 
@@ -99,4 +324,114 @@ size_t segment_manager::get_free_memory() const
     FC_ASSERT(_segment);
     return _segment->get_segment_manager()->get_free_memory();
 }
+
+segment_stats segment_manager::get_segment_stats() const
+{
+    FC_ASSERT(_segment);
+
+    segment_stats stats;
+    stats.size = _segment->get_size();
+    stats.free = get_free_memory();
+
+#ifndef WIN32
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    const size_t chunk_pages = 64 * 1024;
+
+#ifdef __APPLE__
+    std::vector<char> pages(chunk_pages);
+#else
+    std::vector<unsigned char> pages(chunk_pages);
+#endif
+
+    char* address = static_cast<char*>(_segment->get_address());
+    for (size_t offset = 0; offset < stats.size; offset += chunk_pages * page_size)
+    {
+        const size_t length = std::min(chunk_pages * page_size, size_t(stats.size - offset));
+        if (mincore(address + offset, length, pages.data()) != 0)
+        {
+            wlog("Could not get resident pages of the segment file: ${e}", ("e", strerror(errno)));
+            break;
+        }
+
+        const size_t count = (length + page_size - 1) / page_size;
+        for (size_t page = 0; page < count; ++page)
+        {
+            if (pages[page] & 1)
+                stats.resident += page_size;
+        }
+    }
+
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        stats.minor_faults = usage.ru_minflt;
+        stats.major_faults = usage.ru_majflt;
+    }
+#endif
+
+    return stats;
+}
+
+segment_free_blocks segment_manager::get_segment_free_blocks()
+{
+    FC_ASSERT(_segment && !_read_only, "Free blocks are counted in the segment file opened for writing only.");
+
+    std::lock_guard<std::mutex> lock(_free_blocks_mutex);
+
+    auto* manager = _segment->get_segment_manager();
+
+    segment_free_blocks result;
+    result.free = manager->get_free_memory();
+
+    std::vector<segment_free_block_bucket> buckets(64);
+    std::vector<char*> blocks;
+
+    try
+    {
+        // asking for more than the segment has takes the largest free block as a whole, so each call takes the next
+        // block and the sizes come in descending order
+        for (;;)
+        {
+            boost::interprocess::managed_mapped_file::size_type size = manager->get_size();
+            char* reuse = nullptr;
+
+            char* block = manager->allocation_command<char>(
+                boost::interprocess::allocate_new | boost::interprocess::nothrow_allocation, 1, size, reuse);
+            if (!block)
+                break;
+
+            blocks.push_back(block);
+
+            size_t bucket = 0;
+            while (bucket + 1 < buckets.size() && (uint64_t(2) << bucket) <= size)
+                ++bucket;
+
+            ++buckets[bucket].blocks;
+            buckets[bucket].bytes += size;
+
+            ++result.blocks;
+            result.largest = std::max<uint64_t>(result.largest, size);
+        }
+    }
+    catch (...)
+    {
+        for (char* block : blocks)
+            manager->deallocate(block);
+        throw;
+    }
+
+    for (char* block : blocks)
+        manager->deallocate(block);
+
+    for (size_t bucket = 0; bucket < buckets.size(); ++bucket)
+    {
+        if (buckets[bucket].blocks == 0)
+            continue;
+
+        buckets[bucket].min_size = uint64_t(1) << bucket;
+        result.histogram.push_back(buckets[bucket]);
+    }
+
+    return result;
+}
 }
@@ -7,7 +7,10 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/member.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 using namespace boost::multi_index;
 
@@ -30,6 +33,18 @@ typedef fc::shared_multi_index_container<book,
 
 CHAINBASE_SET_INDEX_TYPE(book, book_index)
 
+struct shelf : public chainbase::object<300, shelf>
+{
+    CHAINBASE_DEFAULT_CONSTRUCTOR(shelf)
+
+    id_type id;
+};
+
+typedef fc::shared_multi_index_container<shelf, indexed_by<ordered_unique<member<shelf, shelf::id_type, &shelf::id>>>>
+    shelf_index;
+
+CHAINBASE_SET_INDEX_TYPE(shelf, shelf_index)
+
 class moc_database : public chainbase::database
 {
     typedef chainbase::database _Base;
@@ -146,4 +161,405 @@ BOOST_AUTO_TEST_CASE(open_and_create)
     }
 }
 
+BOOST_AUTO_TEST_CASE(index_slots)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        moc_database db;
+        db.open(temp, chainbase::database::read_write, 1024 * 1024 * 8);
+
+        BOOST_CHECK(!db.has_index<shelf_index>());
+        BOOST_CHECK_THROW(db.get_index<shelf_index>(), std::runtime_error);
+
+        db.add_index<shelf_index>();
+        db.add_index<book_index>();
+
+        BOOST_CHECK(db.has_index<shelf_index>());
+        BOOST_CHECK(db.has_index<book_index>());
+
+        const auto& new_shelf = db.create<shelf>([](shelf&) {});
+        const auto& new_book = db.create<book>([](book& b) { b.a = 3; });
+
+        BOOST_REQUIRE(&db.get(shelf::id_type(0)) == &new_shelf);
+        BOOST_REQUIRE(&db.get(book::id_type(0)) == &new_book);
+        BOOST_REQUIRE_EQUAL(db.get_index<shelf_index>().indices().size(), 1u);
+        BOOST_REQUIRE_EQUAL(db.get_index<book_index>().indices().size(), 1u);
+
+        db.wipe();
+
+        BOOST_CHECK(!db.has_index<shelf_index>());
+        BOOST_CHECK(!db.has_index<book_index>());
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(segment_mapping_options)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        const uint64_t shared_file_size = 1024 * 1024 * 8;
+
+        chainbase::segment_mapping_options options;
+        options.prefault = true;
+        options.access = chainbase::segment_mapping_options::random_access;
+
+        moc_database db;
+        db.set_mapping_options(options);
+        db.open(temp, chainbase::database::read_write, shared_file_size);
+
+        db.add_index<book_index>();
+        db.create<book>([](book& b) { b.a = 3; });
+
+        const chainbase::segment_stats stats = db.get_segment_stats();
+        BOOST_CHECK_EQUAL(stats.size, shared_file_size);
+        BOOST_CHECK_GT(stats.free, 0u);
+        BOOST_CHECK_LT(stats.free, stats.size);
+        BOOST_CHECK_LE(stats.resident, stats.size);
+
+        db.close();
+        boost::filesystem::remove_all(temp);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(checkpoint_marker)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        {
+            moc_database db;
+            db.open(temp, chainbase::database::read_write, 1024 * 1024 * 8);
+            BOOST_CHECK(!db.get_opened_checkpoint());
+
+            db.add_index<book_index>();
+            db.create<book>([](book& b) { b.a = 3; });
+
+            db.flush_in_background(1);
+            db.checkpoint(2);
+            db.close();
+        }
+        {
+            moc_database db;
+            db.open(temp, chainbase::database::read_write, 1024 * 1024 * 8);
+
+            BOOST_REQUIRE(db.get_opened_checkpoint());
+            BOOST_CHECK_EQUAL(db.get_opened_checkpoint()->head, 2u);
+            BOOST_CHECK(db.get_opened_checkpoint()->clean);
+
+            // closed without a checkpoint as if the node was killed
+            db.close();
+        }
+        {
+            moc_database db;
+            db.open(temp, chainbase::database::read_write, 1024 * 1024 * 8);
+
+            BOOST_REQUIRE(db.get_opened_checkpoint());
+            BOOST_CHECK_EQUAL(db.get_opened_checkpoint()->head, 2u);
+            BOOST_CHECK(!db.get_opened_checkpoint()->clean);
+
+            db.close();
+        }
+
+        boost::filesystem::remove_all(temp);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(grow_shared_memory_file)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        const uint64_t shared_file_size = 1024 * 1024 * 8;
+
+        moc_database db;
+        db.open(temp, chainbase::database::read_write, shared_file_size);
+
+        db.add_index<book_index>();
+        db.add_index<shelf_index>();
+
+        for (int i = 0; i < 1000; ++i)
+            db.create<book>([&](book& b) { b.a = i; });
+
+        {
+            auto session = db.start_undo_session();
+            BOOST_CHECK_THROW(db.grow(shared_file_size), std::runtime_error);
+        }
+
+        const size_t free_memory = db.get_segment_stats().free;
+
+        db.grow(shared_file_size);
+
+        BOOST_CHECK_EQUAL(db.get_segment_stats().size, shared_file_size * 2);
+        BOOST_CHECK_GT(db.get_segment_stats().free, free_memory);
+
+        BOOST_REQUIRE_EQUAL(db.get_index<book_index>().indices().size(), 1000u);
+        BOOST_CHECK_EQUAL(db.get(book::id_type(999)).a, 999);
+
+        db.create<shelf>([](shelf&) {});
+        db.modify(db.get(book::id_type(0)), [](book& b) { b.b = 5; });
+        BOOST_CHECK_EQUAL(db.get(book::id_type(0)).b, 5);
+
+        {
+            auto session = db.start_undo_session();
+            db.create<book>([](book& b) { b.a = 1000; });
+        }
+        BOOST_CHECK_EQUAL(db.get_index<book_index>().indices().size(), 1000u);
+
+        db.close();
+        boost::filesystem::remove_all(temp);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(grow_shared_memory_file_with_concurrent_readers)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        const uint64_t shared_file_size = 1024 * 1024 * 8;
+
+        moc_database db;
+        db.open(temp, chainbase::database::read_write, shared_file_size);
+
+        db.add_index<book_index>();
+
+        for (int i = 0; i < 1000; ++i)
+            db.create<book>([&](book& b) { b.a = i; });
+
+        BOOST_CHECK_THROW(db.with_all_locks([]() {}), fc::exception);
+
+        BOOST_TEST_MESSAGE("--- readers keep reading while the file is grown");
+
+        std::atomic<bool> stop(false);
+        std::atomic<uint32_t> reads(0);
+        std::atomic<uint32_t> bad_reads(0);
+
+        std::thread reader([&]() {
+            while (!stop)
+            {
+                db.with_read_lock([&]() {
+                    int sum = 0;
+                    for (const book& b : db.get_index<book_index>().indices())
+                        sum += b.a;
+
+                    if (sum != 999 * 1000 / 2)
+                        ++bad_reads;
+                });
+                ++reads;
+            }
+        });
+
+        for (int i = 0; i < 5; ++i)
+        {
+            db.with_write_lock([&]() { db.with_all_locks([&]() { db.grow(shared_file_size); }); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        stop = true;
+        reader.join();
+
+        BOOST_CHECK_GT(reads, 0u);
+        BOOST_CHECK_EQUAL(bad_reads, 0u);
+        BOOST_CHECK_EQUAL(db.get_segment_stats().size, shared_file_size * 6);
+
+        BOOST_TEST_MESSAGE("--- a reader left on the previous lock by a write lock timeout is waited for");
+
+        std::atomic<bool> reading(false);
+        std::atomic<bool> read_done(false);
+
+        std::thread slow_reader([&]() {
+            db.with_read_lock([&]() {
+                reading = true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                read_done = true;
+            });
+        });
+
+        while (!reading)
+            std::this_thread::yield();
+
+        bool reader_done_before_grow = false;
+
+        // the write lock times out on the lock of the reader and moves to the next one
+        db.with_write_lock(
+            [&]() {
+                db.with_all_locks([&]() {
+                    reader_done_before_grow = read_done;
+                    db.grow(shared_file_size);
+                });
+            },
+            10000);
+
+        slow_reader.join();
+
+        BOOST_CHECK(reader_done_before_grow);
+        BOOST_CHECK_EQUAL(db.get(book::id_type(999)).a, 999);
+
+        db.close();
+        boost::filesystem::remove_all(temp);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(shared_memory_fragmentation_report)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        moc_database db;
+        db.open(temp, chainbase::database::read_write, 1024 * 1024 * 8);
+
+        db.add_index<book_index>();
+        db.add_index<shelf_index>();
+
+        std::vector<const book*> books;
+        for (int i = 0; i < 1000; ++i)
+            books.push_back(&db.create<book>([&](book& b) { b.a = i; }));
+
+        const chainbase::segment_free_blocks unfragmented = db.get_segment_free_blocks();
+
+        // every other book leaves a hole
+        for (size_t i = 0; i < books.size(); i += 2)
+            db.remove(*books[i]);
+
+        {
+            auto session = db.start_undo_session();
+            db.modify(*books[1], [](book& b) { b.b = 2; });
+
+            const std::vector<chainbase::index_memory_stats> indexes = db.get_index_memory_stats();
+            BOOST_REQUIRE_EQUAL(indexes.size(), 2u);
+            BOOST_CHECK_EQUAL(indexes[0].name, "book");
+            BOOST_CHECK_EQUAL(indexes[0].objects, 500u);
+            BOOST_CHECK_EQUAL(indexes[0].undo_sessions, 1u);
+            BOOST_CHECK_EQUAL(indexes[0].undo_values, 1u);
+            BOOST_CHECK_GE(indexes[0].size, indexes[0].objects * sizeof(book));
+            BOOST_CHECK_EQUAL(indexes[1].name, "shelf");
+            BOOST_CHECK_EQUAL(indexes[1].objects, 0u);
+        }
+
+        const size_t free_memory = db.get_segment_stats().free;
+        const chainbase::segment_free_blocks fragmented = db.get_segment_free_blocks();
+
+        // the blocks are released after they are counted
+        BOOST_CHECK_EQUAL(db.get_segment_stats().free, free_memory);
+
+        BOOST_CHECK_EQUAL(fragmented.free, free_memory);
+        BOOST_CHECK_GT(fragmented.blocks, unfragmented.blocks + 400);
+        BOOST_CHECK_LT(fragmented.largest, fragmented.free);
+
+        uint64_t blocks = 0;
+        for (const chainbase::segment_free_block_bucket& bucket : fragmented.histogram)
+        {
+            BOOST_CHECK_GT(bucket.blocks, 0u);
+            BOOST_CHECK_GE(bucket.bytes, bucket.blocks * bucket.min_size);
+            BOOST_CHECK_LT(bucket.bytes, bucket.blocks * bucket.min_size * 2);
+            blocks += bucket.blocks;
+        }
+        BOOST_CHECK_EQUAL(blocks, fragmented.blocks);
+
+        db.close();
+        boost::filesystem::remove_all(temp);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(compact_shared_memory_file)
+{
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    try
+    {
+        const uint64_t shared_file_size = 1024 * 1024 * 8;
+
+        moc_database db;
+        db.open(temp, chainbase::database::read_write, shared_file_size);
+
+        db.add_index<book_index>();
+        db.add_index<shelf_index>();
+
+        std::vector<const book*> books;
+        for (int i = 0; i < 1000; ++i)
+            books.push_back(&db.create<book>([&](book& b) { b.a = i; }));
+
+        for (size_t i = 0; i < books.size(); i += 2)
+            db.remove(*books[i]);
+
+        db.create<shelf>([](shelf&) {});
+
+        {
+            auto session = db.start_undo_session();
+            BOOST_CHECK_THROW(db.compact(shared_file_size), std::runtime_error);
+        }
+
+        const size_t free_memory = db.get_segment_stats().free;
+
+        db.compact(shared_file_size / 2);
+
+        BOOST_CHECK(!boost::filesystem::exists(temp / "shared_memory.bin.compacted"));
+        BOOST_CHECK_EQUAL(db.get_segment_stats().size, shared_file_size / 2);
+        BOOST_CHECK_GT(db.get_segment_stats().free + shared_file_size / 2, free_memory);
+        BOOST_CHECK_EQUAL(db.get_segment_free_blocks().blocks, 1u);
+
+        BOOST_REQUIRE_EQUAL(db.get_index<book_index>().indices().size(), 500u);
+        BOOST_CHECK(db.find(book::id_type(998)) == nullptr);
+        BOOST_CHECK_EQUAL(db.get(book::id_type(999)).a, 999);
+        BOOST_CHECK_EQUAL(db.get_index<book_index>().indices().get<1>().begin()->a, 1);
+        BOOST_CHECK_EQUAL(db.get_index<shelf_index>().indices().size(), 1u);
+
+        // the next ids are kept
+        BOOST_CHECK(db.create<book>([](book& b) { b.a = 1000; }).id == book::id_type(1000));
+        BOOST_CHECK(db.create<shelf>([](shelf&) {}).id == shelf::id_type(1));
+
+        {
+            auto session = db.start_undo_session();
+            db.modify(db.get(book::id_type(1)), [](book& b) { b.b = 5; });
+            db.undo();
+        }
+        BOOST_CHECK_EQUAL(db.get(book::id_type(1)).b, 1);
+
+        db.close();
+
+        moc_database reopened;
+        reopened.open(temp, chainbase::database::read_write);
+        reopened.add_index<book_index>();
+        reopened.add_index<shelf_index>();
+        BOOST_CHECK_EQUAL(reopened.get_index<book_index>().indices().size(), 501u);
+        reopened.close();
+
+        boost::filesystem::remove_all(temp);
+    }
+    catch (...)
+    {
+        boost::filesystem::remove_all(temp);
+        throw;
+    }
+}
+
 // BOOST_AUTO_TEST_SUITE_END()
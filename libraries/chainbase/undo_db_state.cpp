@@ -12,9 +12,16 @@ private:
     friend class undo_db_state;
 
 public:
-    session_container(abstract_undo_session_list&& s)
+    session_container(abstract_undo_session_list&& s, size_t& active_sessions)
         : _session_list(std::move(s))
+        , _active_sessions(active_sessions)
     {
+        ++_active_sessions;
+    }
+
+    ~session_container()
+    {
+        --_active_sessions;
     }
 
     virtual void push() override
@@ -22,6 +29,9 @@ public:
         for (auto& i : _session_list)
             i->push();
     }
+
+private:
+    size_t& _active_sessions;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -32,6 +42,6 @@ abstract_undo_session_ptr undo_db_state::start_undo_session()
 
     for_each_index([&](abstract_generic_index_i& item) { sub_sessions.push_back(item.start_undo_session()); });
 
-    return std::move(abstract_undo_session_ptr(new session_container(std::move(sub_sessions))));
+    return std::move(abstract_undo_session_ptr(new session_container(std::move(sub_sessions), _active_undo_sessions)));
 }
 }
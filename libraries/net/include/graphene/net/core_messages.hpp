@@ -105,9 +105,9 @@ struct block_message
     static const core_message_type_enum type;
 
     block_message() {}
-    block_message(const signed_block& blk)
-        : block(blk)
-        , block_id(blk.id())
+    block_message(signed_block blk)
+        : block(std::move(blk))
+        , block_id(block.id())
     {
     }
 
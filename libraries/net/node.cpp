@@ -730,7 +730,7 @@ public:
     void process_backlog_of_sync_blocks();
     void trigger_process_backlog_of_sync_blocks();
     void process_block_during_sync(peer_connection* originating_peer,
-                                   const graphene::net::block_message& block_message,
+                                   graphene::net::block_message&& block_message,
                                    const message_hash_type& message_hash);
     void process_block_during_normal_operation(peer_connection* originating_peer,
                                                const graphene::net::block_message& block_message,
@@ -3559,11 +3559,13 @@ void node_impl::process_backlog_of_sync_blocks()
                               received_block_iter->block_id)
                     == _most_recent_blocks_accepted.end())
                 {
-                    graphene::net::block_message block_message_to_process = *received_block_iter;
+                    // the block is moved out of the list and shared with the task, so it is not copied again
+                    auto block_message_to_process
+                        = std::make_shared<graphene::net::block_message>(std::move(*received_block_iter));
                     _received_sync_items.erase(received_block_iter);
                     _handle_message_calls_in_progress.emplace_back(fc::async(
                         [this, block_message_to_process]() {
-                            send_sync_block_to_node_delegate(block_message_to_process);
+                            send_sync_block_to_node_delegate(*block_message_to_process);
                         },
                         "send_sync_block_to_node_delegate"));
                     ++blocks_processed;
@@ -3631,7 +3633,7 @@ void node_impl::trigger_process_backlog_of_sync_blocks()
 }
 
 void node_impl::process_block_during_sync(peer_connection* originating_peer,
-                                          const graphene::net::block_message& block_message_to_process,
+                                          graphene::net::block_message&& block_message_to_process,
                                           const message_hash_type& message_hash)
 {
     VERIFY_CORRECT_THREAD();
@@ -3639,7 +3641,7 @@ void node_impl::process_block_during_sync(peer_connection* originating_peer,
 
     // add it to the front of _received_sync_items, then process _received_sync_items to try to
     // pass as many messages as possible to the client.
-    _new_received_sync_items.push_front(block_message_to_process);
+    _new_received_sync_items.push_front(std::move(block_message_to_process));
     trigger_process_backlog_of_sync_blocks();
 }
 
@@ -3844,7 +3846,7 @@ void node_impl::process_block_message(peer_connection* originating_peer,
             {
                 originating_peer->last_sync_item_received_time = fc::time_point::now();
                 _active_sync_requests.erase(block_message_to_process.block_id);
-                process_block_during_sync(originating_peer, block_message_to_process, message_hash);
+                process_block_during_sync(originating_peer, std::move(block_message_to_process), message_hash);
                 if (originating_peer->idle())
                 {
                     // we have finished fetching a batch of items, so we either need to grab another batch of items
@@ -1,6 +1,8 @@
 #include <scorum/account_by_key/account_by_key_api.hpp>
 #include <scorum/account_by_key/account_by_key_objects.hpp>
 
+#include <algorithm>
+
 namespace scorum {
 namespace account_by_key {
 
@@ -30,14 +32,16 @@ account_by_key_api_impl::get_key_references(std::vector<public_key_type>& keys)
     for (auto& key : keys)
     {
         std::vector<account_name_type> result;
-        auto lookup_itr = key_idx.lower_bound(key);
+        auto range = key_idx.equal_range(key);
 
-        while (lookup_itr != key_idx.end() && lookup_itr->key == key)
+        for (auto lookup_itr = range.first; lookup_itr != range.second; ++lookup_itr)
         {
             result.push_back(lookup_itr->account);
-            ++lookup_itr;
         }
 
+        // hashed index keeps no order within a key, return accounts sorted as before
+        std::sort(result.begin(), result.end());
+
         final_result.emplace_back(std::move(result));
     }
 
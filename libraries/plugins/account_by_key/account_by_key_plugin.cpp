@@ -27,16 +27,37 @@ public:
         return _self.database();
     }
 
+    void pre_block(const signed_block& b);
+    void post_block(const signed_block& b);
     void pre_operation(const operation_notification& op_obj);
     void post_operation(const operation_notification& op_obj);
     void clear_cache();
     void cache_auths(const account_authority_object& a);
+    void update_key_lookup(const account_name_type& account, const flat_set<public_key_type>& new_keys);
     void update_key_lookup(const account_authority_object& a);
+    void flush_key_lookup();
 
     flat_set<public_key_type> cached_keys;
+    flat_set<public_key_type> cached_new_keys;
+
+    /// key lookups changed by operations of the current block, true to add the lookup and false to remove it
+    std::map<std::pair<public_key_type, account_name_type>, bool> pending_lookups;
+
     account_by_key_plugin& _self;
 };
 
+inline void insert_keys(flat_set<public_key_type>& keys, const authority& auth)
+{
+    for (const auto& item : auth.key_auths)
+        keys.insert(item.first);
+}
+
+inline void insert_keys(flat_set<public_key_type>& keys, const shared_authority& auth)
+{
+    for (const auto& item : auth.key_auths)
+        keys.insert(item.first);
+}
+
 struct pre_operation_visitor
 {
     account_by_key_plugin& _plugin;
@@ -52,27 +73,29 @@ struct pre_operation_visitor
     {
     }
 
-    void operator()(const account_create_operation& op) const
-    {
-        _plugin.my->clear_cache();
-    }
-
-    void operator()(const account_create_with_delegation_operation& op) const
-    {
-        _plugin.my->clear_cache();
-    }
-
-    void operator()(const account_create_by_committee_operation& op) const
-    {
-        _plugin.my->clear_cache();
-    }
-
     void operator()(const account_update_operation& op) const
     {
         _plugin.my->clear_cache();
         auto acct_itr = _plugin.database().find<account_authority_object, by_account>(op.account);
         if (acct_itr)
+        {
             _plugin.my->cache_auths(*acct_itr);
+
+            // authorities that are not in the operation are left untouched by it
+            auto& new_keys = _plugin.my->cached_new_keys;
+            if (op.owner)
+                insert_keys(new_keys, *op.owner);
+            else
+                insert_keys(new_keys, acct_itr->owner);
+            if (op.active)
+                insert_keys(new_keys, *op.active);
+            else
+                insert_keys(new_keys, acct_itr->active);
+            if (op.posting)
+                insert_keys(new_keys, *op.posting);
+            else
+                insert_keys(new_keys, acct_itr->posting);
+        }
     }
 
     void operator()(const recover_account_operation& op) const
@@ -80,17 +103,14 @@ struct pre_operation_visitor
         _plugin.my->clear_cache();
         auto acct_itr = _plugin.database().find<account_authority_object, by_account>(op.account_to_recover);
         if (acct_itr)
+        {
             _plugin.my->cache_auths(*acct_itr);
-    }
-};
-
-struct pow2_work_get_account_visitor
-{
-    typedef const account_name_type* result_type;
 
-    template <typename WorkType> result_type operator()(const WorkType& work) const
-    {
-        return &work.input.worker_account;
+            auto& new_keys = _plugin.my->cached_new_keys;
+            insert_keys(new_keys, op.new_owner_authority);
+            insert_keys(new_keys, acct_itr->active);
+            insert_keys(new_keys, acct_itr->posting);
+        }
     }
 };
 
@@ -109,39 +129,40 @@ struct post_operation_visitor
     {
     }
 
+    template <typename CreateOperation> void create_key_lookup(const CreateOperation& op) const
+    {
+        flat_set<public_key_type> new_keys;
+        insert_keys(new_keys, op.owner);
+        insert_keys(new_keys, op.active);
+        insert_keys(new_keys, op.posting);
+
+        _plugin.my->clear_cache();
+        _plugin.my->update_key_lookup(op.new_account_name, new_keys);
+    }
+
     void operator()(const account_create_operation& op) const
     {
-        auto acct_itr = _plugin.database().find<account_authority_object, by_account>(op.new_account_name);
-        if (acct_itr)
-            _plugin.my->update_key_lookup(*acct_itr);
+        create_key_lookup(op);
     }
 
     void operator()(const account_create_with_delegation_operation& op) const
     {
-        auto acct_itr = _plugin.database().find<account_authority_object, by_account>(op.new_account_name);
-        if (acct_itr)
-            _plugin.my->update_key_lookup(*acct_itr);
+        create_key_lookup(op);
     }
 
     void operator()(const account_create_by_committee_operation& op) const
     {
-        auto acct_itr = _plugin.database().find<account_authority_object, by_account>(op.new_account_name);
-        if (acct_itr)
-            _plugin.my->update_key_lookup(*acct_itr);
+        create_key_lookup(op);
     }
 
     void operator()(const account_update_operation& op) const
     {
-        auto acct_itr = _plugin.database().find<account_authority_object, by_account>(op.account);
-        if (acct_itr)
-            _plugin.my->update_key_lookup(*acct_itr);
+        _plugin.my->update_key_lookup(op.account, _plugin.my->cached_new_keys);
     }
 
     void operator()(const recover_account_operation& op) const
     {
-        auto acct_itr = _plugin.database().find<account_authority_object, by_account>(op.account_to_recover);
-        if (acct_itr)
-            _plugin.my->update_key_lookup(*acct_itr);
+        _plugin.my->update_key_lookup(op.account_to_recover, _plugin.my->cached_new_keys);
     }
 
     void operator()(const hardfork_operation& op) const
@@ -153,46 +174,26 @@ struct post_operation_visitor
 void account_by_key_plugin_impl::clear_cache()
 {
     cached_keys.clear();
+    cached_new_keys.clear();
 }
 
 void account_by_key_plugin_impl::cache_auths(const account_authority_object& a)
 {
-    for (const auto& item : a.owner.key_auths)
-        cached_keys.insert(item.first);
-    for (const auto& item : a.active.key_auths)
-        cached_keys.insert(item.first);
-    for (const auto& item : a.posting.key_auths)
-        cached_keys.insert(item.first);
+    insert_keys(cached_keys, a.owner);
+    insert_keys(cached_keys, a.active);
+    insert_keys(cached_keys, a.posting);
 }
 
-void account_by_key_plugin_impl::update_key_lookup(const account_authority_object& a)
+void account_by_key_plugin_impl::update_key_lookup(const account_name_type& account,
+                                                   const flat_set<public_key_type>& new_keys)
 {
-    auto& db = database();
-    flat_set<public_key_type> new_keys;
-
-    // Construct the set of keys in the account's authority
-    for (const auto& item : a.owner.key_auths)
-        new_keys.insert(item.first);
-    for (const auto& item : a.active.key_auths)
-        new_keys.insert(item.first);
-    for (const auto& item : a.posting.key_auths)
-        new_keys.insert(item.first);
-
     // For each key that needs a lookup
     for (const auto& key : new_keys)
     {
         // If the key was not in the authority, add it to the lookup
         if (cached_keys.find(key) == cached_keys.end())
         {
-            auto lookup_itr = db.find<key_lookup_object, by_key>(std::make_tuple(key, a.account));
-
-            if (lookup_itr == nullptr)
-            {
-                db.create<key_lookup_object>([&](key_lookup_object& o) {
-                    o.key = key;
-                    o.account = a.account;
-                });
-            }
+            pending_lookups[std::make_pair(key, account)] = true;
         }
         else
         {
@@ -204,25 +205,90 @@ void account_by_key_plugin_impl::update_key_lookup(const account_authority_objec
     // Loop over the keys that were in authority but are no longer and remove them from the lookup
     for (const auto& key : cached_keys)
     {
-        auto lookup_itr = db.find<key_lookup_object, by_key>(std::make_tuple(key, a.account));
+        pending_lookups[std::make_pair(key, account)] = false;
+    }
 
-        if (lookup_itr != nullptr)
+    clear_cache();
+}
+
+void account_by_key_plugin_impl::update_key_lookup(const account_authority_object& a)
+{
+    flat_set<public_key_type> new_keys;
+
+    // Construct the set of keys in the account's authority
+    insert_keys(new_keys, a.owner);
+    insert_keys(new_keys, a.active);
+    insert_keys(new_keys, a.posting);
+
+    clear_cache();
+    update_key_lookup(a.account, new_keys);
+}
+
+void account_by_key_plugin_impl::flush_key_lookup()
+{
+    auto& db = database();
+    const auto& key_idx = db.get_index<key_lookup_index>().indices().get<by_key>();
+
+    for (const auto& item : pending_lookups)
+    {
+        const public_key_type& key = item.first.first;
+        const account_name_type& account = item.first.second;
+
+        const key_lookup_object* lookup = nullptr;
+        for (auto range = key_idx.equal_range(key); range.first != range.second; ++range.first)
+        {
+            if (range.first->account == account)
+            {
+                lookup = &(*range.first);
+                break;
+            }
+        }
+
+        if (item.second && lookup == nullptr)
+        {
+            db.create<key_lookup_object>([&](key_lookup_object& o) {
+                o.key = key;
+                o.account = account;
+            });
+        }
+        else if (!item.second && lookup != nullptr)
         {
-            db.remove(*lookup_itr);
+            db.remove(*lookup);
         }
     }
 
-    cached_keys.clear();
+    pending_lookups.clear();
+}
+
+void account_by_key_plugin_impl::pre_block(const signed_block&)
+{
+    // drop changes collected from pending transactions, they are undone before the block is applied
+    pending_lookups.clear();
+}
+
+void account_by_key_plugin_impl::post_block(const signed_block&)
+{
+    flush_key_lookup();
 }
 
 void account_by_key_plugin_impl::pre_operation(const operation_notification& note)
 {
-    note.op.visit(pre_operation_visitor(_self));
+    static const operation_mask handled_operations
+        = make_operation_mask<account_update_operation, recover_account_operation>();
+
+    if (handled_operations.test(note.op.which()))
+        note.op.visit(pre_operation_visitor(_self));
 }
 
 void account_by_key_plugin_impl::post_operation(const operation_notification& note)
 {
-    note.op.visit(post_operation_visitor(_self));
+    static const operation_mask handled_operations
+        = make_operation_mask<account_create_operation, account_create_with_delegation_operation,
+                              account_create_by_committee_operation, account_update_operation,
+                              recover_account_operation>();
+
+    if (handled_operations.test(note.op.which()))
+        note.op.visit(post_operation_visitor(_self));
 }
 
 } // detail
@@ -244,8 +310,12 @@ void account_by_key_plugin::plugin_initialize(const boost::program_options::vari
     {
         chain::database& db = database();
 
-        db.pre_apply_operation.connect([&](const operation_notification& o) { my->pre_operation(o); });
-        db.post_apply_operation.connect([&](const operation_notification& o) { my->post_operation(o); });
+        db.connect_plugin_handler(plugin_name(), db.pre_apply_block, [&](const signed_block& b) { my->pre_block(b); });
+        db.connect_plugin_handler(plugin_name(), db.applied_block, [&](const signed_block& b) { my->post_block(b); });
+        db.connect_plugin_handler(plugin_name(), db.pre_apply_operation,
+                                  [&](const operation_notification& o) { my->pre_operation(o); });
+        db.connect_plugin_handler(plugin_name(), db.post_apply_operation,
+                                  [&](const operation_notification& o) { my->post_operation(o); });
 
         db.add_plugin_index<key_lookup_index>();
     }
@@ -274,6 +344,8 @@ void account_by_key_plugin::plugin_startup()
         }
         ++it;
     }
+
+    my->flush_key_lookup();
 }
 }
 } // scorum::account_by_key
@@ -1,7 +1,9 @@
 #pragma once
 #include <scorum/chain/schema/scorum_object_types.hpp>
 
-#include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+
+#include <cstring>
 
 namespace scorum {
 namespace account_by_key {
@@ -30,6 +32,19 @@ public:
 
 typedef key_lookup_object::id_type key_lookup_id_type;
 
+/**
+ * Public keys are compressed EC points, bytes after the parity prefix are uniformly distributed already.
+ */
+struct public_key_hash
+{
+    std::size_t operator()(const public_key_type& key) const
+    {
+        std::size_t result = 0;
+        std::memcpy(&result, key.key_data.begin() + 1, sizeof(result));
+        return result;
+    }
+};
+
 using namespace boost::multi_index;
 
 struct by_key;
@@ -39,14 +54,11 @@ typedef shared_multi_index_container<key_lookup_object,
                                                                member<key_lookup_object,
                                                                       key_lookup_id_type,
                                                                       &key_lookup_object::id>>,
-                                                ordered_unique<tag<by_key>,
-                                                               composite_key<key_lookup_object,
-                                                                             member<key_lookup_object,
-                                                                                    public_key_type,
-                                                                                    &key_lookup_object::key>,
-                                                                             member<key_lookup_object,
-                                                                                    account_name_type,
-                                                                                    &key_lookup_object::account>>>>>
+                                                hashed_non_unique<tag<by_key>,
+                                                                  member<key_lookup_object,
+                                                                         public_key_type,
+                                                                         &key_lookup_object::key>,
+                                                                  public_key_hash>>>
     key_lookup_index;
 }
 } // scorum::account_by_key
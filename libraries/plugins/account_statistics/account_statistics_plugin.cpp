@@ -13,7 +13,9 @@ namespace account_statistics {
 namespace detail {
 
 class account_statistics_plugin_impl
-    : public common_statistics::common_statistics_plugin_impl<bucket_object, account_statistics_plugin>
+    : public common_statistics::common_statistics_plugin_impl<bucket_object,
+                                                              account_statistics_plugin,
+                                                              account_metric_map>
 {
 public:
     account_statistics_plugin_impl(account_statistics_plugin& plugin)
@@ -24,7 +26,20 @@ public:
     {
     }
 
-    virtual void process_post_operation(const bucket_object& bucket, const operation_notification& o) override;
+    virtual void process_post_operation(account_metric_map& delta, const operation_notification& o) override;
+
+    virtual void apply_delta(bucket_object& bucket, const account_metric_map& delta) override
+    {
+        for (const auto& item : delta)
+        {
+            bucket.account_statistic[item.first] += item.second;
+        }
+    }
+
+    virtual bool is_empty(const account_metric_map& delta) const override
+    {
+        return delta.empty();
+    }
 };
 
 struct activity_operation_process
@@ -47,12 +62,10 @@ struct activity_operation_process
 
 struct operation_process
 {
-    chain::database& _db;
-    const bucket_object& _bucket;
+    account_metric_map& _delta;
 
-    operation_process(chain::database& db, const bucket_object& b)
-        : _db(db)
-        , _bucket(b)
+    operation_process(account_metric_map& delta)
+        : _delta(delta)
     {
     }
 
@@ -64,24 +77,19 @@ struct operation_process
 
     void operator()(const transfer_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            auto& from_stat = b.account_statistic[op.from];
-            from_stat.transfers_from++;
-            from_stat.scorum_sent += op.amount;
-
-            auto& to_stat = b.account_statistic[op.to];
-            to_stat.transfers_to++;
-            to_stat.scorum_received += op.amount;
-        });
+        auto& from_stat = _delta[op.from];
+        from_stat.transfers_from++;
+        from_stat.scorum_sent += op.amount;
+
+        auto& to_stat = _delta[op.to];
+        to_stat.transfers_to++;
+        to_stat.scorum_received += op.amount;
     }
 };
 
-void account_statistics_plugin_impl::process_post_operation(const bucket_object& bucket,
-                                                            const operation_notification& o)
+void account_statistics_plugin_impl::process_post_operation(account_metric_map& delta, const operation_notification& o)
 {
-    auto& db = _self.database();
-
-    o.op.visit(operation_process(db, bucket));
+    o.op.visit(operation_process(delta));
 }
 
 } // namespace detail
@@ -64,9 +64,13 @@ struct account_metric
     uint32_t curation_reward_payouts = 0; ///< Number of curation reward payouts.
     asset curation_rewards_scorumpower = asset(0, SP_SYMBOL); ///< SP paid for curation rewards
     asset curation_rewards_scorum_value = asset(0, SCORUM_SYMBOL); ///< SCR value of curation rewards
+
+    account_metric& operator+=(const account_metric&);
 };
 // clang-format on
 
+typedef std::map<account_name_type, account_metric> account_metric_map;
+
 struct account_statistic : public account_metric
 {
     account_statistic& operator+=(const account_metric&);
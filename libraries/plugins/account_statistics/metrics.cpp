@@ -4,7 +4,7 @@
 namespace scorum {
 namespace account_statistics {
 
-account_statistic& account_statistic::operator+=(const account_metric& stat)
+account_metric& account_metric::operator+=(const account_metric& stat)
 {
     this->signed_transactions += stat.signed_transactions;
 
@@ -58,6 +58,13 @@ account_statistic& account_statistic::operator+=(const account_metric& stat)
     return (*this);
 }
 
+account_statistic& account_statistic::operator+=(const account_metric& stat)
+{
+    account_metric::operator+=(stat);
+
+    return (*this);
+}
+
 //////////////////////////////////////////////////////////////////////////
 statistics& statistics::operator+=(const bucket_object& bucket)
 {
@@ -30,7 +30,8 @@ void block_info_plugin::plugin_initialize(const boost::program_options::variable
 {
     chain::database& db = database();
 
-    _applied_block_conn = db.applied_block.connect([this](const chain::signed_block& b) { on_applied_block(b); });
+    _applied_block_conn = db.connect_plugin_handler(plugin_name(), db.applied_block,
+                                                    [this](const chain::signed_block& b) { on_applied_block(b); });
 }
 
 void block_info_plugin::plugin_startup()
@@ -0,0 +1,66 @@
+#include <scorum/app/api_context.hpp>
+#include <scorum/app/application.hpp>
+
+#include <scorum/plugins/block_profiler/block_profiler_api.hpp>
+
+namespace scorum {
+namespace plugin {
+namespace block_profiler {
+
+namespace detail {
+
+class block_profiler_api_impl
+{
+public:
+    block_profiler_api_impl(scorum::app::application& _app);
+
+    scorum::app::application& app;
+};
+
+block_profiler_api_impl::block_profiler_api_impl(scorum::app::application& _app)
+    : app(_app)
+{
+}
+
+} // detail
+
+block_profiler_api::block_profiler_api(const scorum::app::api_context& ctx)
+{
+    my = std::make_shared<detail::block_profiler_api_impl>(ctx.app);
+}
+
+void block_profiler_api::on_api_startup()
+{
+}
+
+chain::block_profile block_profiler_api::get_block_profile() const
+{
+    std::shared_ptr<chain::database> db = my->app.chain_database();
+
+    // the profile is updated while blocks are applied under the write lock
+    return db->with_read_lock([&]() { return db->get_block_profiler().get_profile(); });
+}
+
+chain::block_profile block_profiler_api::get_last_block_profile() const
+{
+    std::shared_ptr<chain::database> db = my->app.chain_database();
+
+    return db->with_read_lock([&]() { return db->get_block_profiler().get_last_block_profile(); });
+}
+
+chainbase::segment_stats block_profiler_api::get_shared_memory_stats() const
+{
+    std::shared_ptr<chain::database> db = my->app.chain_database();
+
+    return db->with_read_lock([&]() { return db->get_segment_stats(); });
+}
+
+std::vector<chainbase::index_memory_stats> block_profiler_api::get_shared_memory_indexes() const
+{
+    std::shared_ptr<chain::database> db = my->app.chain_database();
+
+    return db->with_read_lock([&]() { return db->get_index_memory_stats(); });
+}
+}
+}
+} // scorum::plugin::block_profiler
@@ -0,0 +1,63 @@
+#include <scorum/plugins/block_profiler/block_profiler_api.hpp>
+#include <scorum/plugins/block_profiler/block_profiler_plugin.hpp>
+
+#include <scorum/chain/database/database.hpp>
+
+#include <string>
+
+namespace scorum {
+namespace plugin {
+namespace block_profiler {
+
+block_profiler_plugin::block_profiler_plugin(application* app)
+    : plugin(app)
+{
+}
+
+block_profiler_plugin::~block_profiler_plugin()
+{
+}
+
+std::string block_profiler_plugin::plugin_name() const
+{
+    return "block_profiler";
+}
+
+void block_profiler_plugin::plugin_set_program_options(boost::program_options::options_description& cli,
+                                                       boost::program_options::options_description& cfg)
+{
+    cli.add_options()("block-profile-window",
+                      boost::program_options::value<uint32_t>()->default_value(
+                          chain::block_profiler::default_window_blocks),
+                      "Number of blocks in the rolling window of the block application profile (default: 1200)")(
+        "block-profile-dump-ms", boost::program_options::value<uint32_t>(),
+        "Log the phases of every block applied in more than this many milliseconds, 0 logs every block");
+    cfg.add(cli);
+}
+
+void block_profiler_plugin::plugin_initialize(const boost::program_options::variables_map& options)
+{
+    print_greeting();
+
+    chain::block_profiler& profiler = database().get_block_profiler();
+
+    if (options.count("block-profile-window"))
+        profiler.set_window(options.at("block-profile-window").as<uint32_t>());
+
+    if (options.count("block-profile-dump-ms"))
+        profiler.set_dump_threshold(fc::milliseconds(options.at("block-profile-dump-ms").as<uint32_t>()));
+}
+
+void block_profiler_plugin::plugin_startup()
+{
+    app().register_api_factory<block_profiler_api>("block_profiler_api");
+}
+
+void block_profiler_plugin::plugin_shutdown()
+{
+}
+}
+}
+} // scorum::plugin::block_profiler
+
+SCORUM_DEFINE_PLUGIN(block_profiler, scorum::plugin::block_profiler::block_profiler_plugin)
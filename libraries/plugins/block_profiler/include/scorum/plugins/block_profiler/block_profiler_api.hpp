@@ -0,0 +1,54 @@
+#pragma once
+
+#include <scorum/chain/database/block_profiler.hpp>
+
+#include <chainbase/abstract_interfaces.hpp>
+#include <chainbase/segment_manager.hpp>
+
+#include <fc/api.hpp>
+
+namespace scorum {
+namespace app {
+struct api_context;
+}
+}
+
+namespace scorum {
+namespace plugin {
+namespace block_profiler {
+
+namespace detail {
+class block_profiler_api_impl;
+}
+
+class block_profiler_api
+{
+public:
+    block_profiler_api(const scorum::app::api_context& ctx);
+
+    void on_api_startup();
+
+    /// time spent in the phases of block application and in the plugin handlers over the rolling window
+    chain::block_profile get_block_profile() const;
+
+    /// time spent in the phases of the last applied block
+    chain::block_profile get_last_block_profile() const;
+
+    /// resident size of the shared memory file and page faults of the node
+    chainbase::segment_stats get_shared_memory_stats() const;
+
+    /// objects and undo state of the indexes of the shared memory file
+    std::vector<chainbase::index_memory_stats> get_shared_memory_indexes() const;
+
+private:
+    std::shared_ptr<detail::block_profiler_api_impl> my;
+};
+}
+}
+}
+
+FC_REFLECT(chainbase::segment_stats, (size)(free)(resident)(minor_faults)(major_faults))
+FC_REFLECT(chainbase::index_memory_stats, (name)(objects)(node_size)(undo_sessions)(undo_values)(size))
+
+FC_API(scorum::plugin::block_profiler::block_profiler_api,
+       (get_block_profile)(get_last_block_profile)(get_shared_memory_stats)(get_shared_memory_indexes))
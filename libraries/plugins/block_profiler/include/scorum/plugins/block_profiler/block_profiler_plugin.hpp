@@ -0,0 +1,29 @@
+#pragma once
+
+#include <scorum/app/plugin.hpp>
+
+namespace scorum {
+namespace plugin {
+namespace block_profiler {
+
+using scorum::app::application;
+
+/**
+ * Configures the block application profiler of the chain database and provides block_profiler_api
+ */
+class block_profiler_plugin : public scorum::app::plugin
+{
+public:
+    block_profiler_plugin(application* app);
+    virtual ~block_profiler_plugin();
+
+    virtual std::string plugin_name() const override;
+    virtual void plugin_set_program_options(boost::program_options::options_description& cli,
+                                            boost::program_options::options_description& cfg) override;
+    virtual void plugin_initialize(const boost::program_options::variables_map& options) override;
+    virtual void plugin_startup() override;
+    virtual void plugin_shutdown() override;
+};
+}
+}
+}
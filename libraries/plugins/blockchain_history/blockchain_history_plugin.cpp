@@ -42,7 +42,8 @@ public:
         db.add_plugin_index<filtered_operation_index<applied_operation_type::virt>>();
         db.add_plugin_index<filtered_operation_index<applied_operation_type::market>>();
 
-        db.pre_apply_operation.connect([&](const operation_notification& note) { on_operation(note); });
+        db.connect_plugin_handler(_self.plugin_name(), db.pre_apply_operation,
+                                  [&](const operation_notification& note) { on_operation(note); });
     }
     virtual ~blockchain_history_plugin_impl()
     {
@@ -62,8 +63,26 @@ public:
     bool _filter_content = false;
     bool _blacklist = false;
     flat_set<std::string> _op_list;
+    operation_mask _op_filter;
+
+    void build_op_filter();
 };
 
+void blockchain_history_plugin_impl::build_op_filter()
+{
+    for (const std::string& name : _op_list)
+    {
+        int tag = get_operation_tag(name);
+        if (tag < 0)
+        {
+            wlog("Account History: unknown operation ${o}", ("o", name));
+            continue;
+        }
+
+        _op_filter.set(tag);
+    }
+}
+
 class operation_visitor
 {
     database& _db;
@@ -114,37 +133,6 @@ private:
     }
 };
 
-struct operation_visitor_filter
-{
-    operation_visitor_filter(const flat_set<std::string>& filter, bool blacklist)
-        : _filter(filter)
-        , _blacklist(blacklist)
-    {
-    }
-
-    using result_type = bool;
-
-    template <typename T> bool operator()(const T& op) const
-    {
-        if (_filter.find(fc::get_typename<T>::name()) != _filter.end())
-        {
-            if (!_blacklist)
-                return true;
-        }
-        else
-        {
-            if (_blacklist)
-                return true;
-        }
-
-        return false;
-    }
-
-private:
-    const flat_set<std::string>& _filter;
-    bool _blacklist;
-};
-
 struct filtered_operation_obj_creator_visitor
 {
     filtered_operation_obj_creator_visitor(chain::database& db, const operation_object::id_type& id)
@@ -228,7 +216,8 @@ void blockchain_history_plugin_impl::on_operation(const operation_notification&
     flat_set<account_name_type> impacted;
     scorum::chain::database& db = database();
 
-    if (_filter_content && !note.op.visit(operation_visitor_filter(_op_list, _blacklist)))
+    // an operation is kept if it is in the whitelist or is not in the blacklist
+    if (_filter_content && _op_filter.test(note.op.which()) == _blacklist)
         return;
 
     app::operation_get_impacted_accounts(note.op, impacted);
@@ -324,6 +313,8 @@ void blockchain_history_plugin::plugin_initialize(const boost::program_options::
             }
         }
 
+        my->build_op_filter();
+
         ilog("Account History: whitelisting ops ${o}", ("o", my->_op_list));
     }
     else if (options.count("history-blacklist-ops"))
@@ -342,6 +333,8 @@ void blockchain_history_plugin::plugin_initialize(const boost::program_options::
             }
         }
 
+        my->build_op_filter();
+
         ilog("Account History: blacklisting ops ${o}", ("o", my->_op_list));
     }
     print_greeting();
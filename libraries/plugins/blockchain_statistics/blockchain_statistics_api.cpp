@@ -13,6 +13,50 @@ public:
         : base_api_impl(app, BLOCKCHAIN_STATISTICS_PLUGIN_NAME)
     {
     }
+
+    bool has_timeline() const
+    {
+        return _app.get_plugin<blockchain_statistics_plugin>(_plugin_name)->get_timeline_resolution() != 0;
+    }
+
+    /// the timeline has a checkpoint before time or it has not been pruned, so totals before time are known
+    bool timeline_covers(const fc::time_point_sec& time) const
+    {
+        const auto& timeline_idx = _app.chain_database()->get_index<timeline_index>().indices().get<by_open>();
+        if (timeline_idx.empty())
+            return false;
+
+        // the first checkpoint ever created has the first id, it is the first one to be pruned
+        return timeline_idx.begin()->open < time || timeline_idx.begin()->id == timeline_id_type(0);
+    }
+
+    /// totals of all blocks before time, rounded up to the timeline resolution
+    base_metric get_cumulative_metric(const fc::time_point_sec& time) const
+    {
+        const auto& timeline_idx = _app.chain_database()->get_index<timeline_index>().indices().get<by_open>();
+        auto itr = timeline_idx.lower_bound(time);
+
+        if (itr == timeline_idx.begin())
+            return base_metric();
+
+        --itr;
+        return *itr;
+    }
+
+    statistics get_stats_from_timeline(const fc::time_point_sec& start, const fc::time_point_sec& end) const
+    {
+        statistics result;
+
+        if (start < end)
+        {
+            base_metric delta = get_cumulative_metric(end);
+            delta -= get_cumulative_metric(start);
+
+            result += delta;
+        }
+
+        return result;
+    }
 };
 } // namespace detail
 
@@ -33,8 +77,12 @@ statistics blockchain_statistics_api::get_stats_for_time(const fc::time_point_se
 statistics blockchain_statistics_api::get_stats_for_interval(const fc::time_point_sec& start,
                                                              const fc::time_point_sec& end) const
 {
-    return my->_app.chain_database()->with_read_lock(
-        [&]() { return my->get_stats_for_interval<blockchain_statistics_plugin>(start, end); });
+    return my->_app.chain_database()->with_read_lock([&]() {
+        if (my->has_timeline() && my->timeline_covers(start))
+            return my->get_stats_from_timeline(start, end);
+
+        return my->get_stats_for_interval<blockchain_statistics_plugin>(start, end);
+    });
 }
 
 statistics blockchain_statistics_api::get_lifetime_stats() const
@@ -22,7 +22,7 @@ namespace detail {
 using namespace scorum::protocol;
 
 class blockchain_statistics_plugin_impl
-    : public common_statistics::common_statistics_plugin_impl<bucket_object, blockchain_statistics_plugin>
+    : public common_statistics::common_statistics_plugin_impl<bucket_object, blockchain_statistics_plugin, base_metric>
 {
 public:
     blockchain_statistics_plugin_impl(blockchain_statistics_plugin& plugin)
@@ -33,30 +33,33 @@ public:
     {
     }
 
-    virtual void process_bucket_creation(const bucket_object& bucket)
-    {
-        auto& db = _self.database();
+    virtual void process_block(base_metric& delta, const signed_block& b) override;
 
-        db.modify<bucket_object>(bucket, [&](bucket_object& bo) { bo.blocks = 1; });
-    }
+    virtual void process_pre_operation(base_metric& delta, const operation_notification& o) override;
 
-    virtual void process_block(const bucket_object& bucket, const signed_block& b) override;
+    virtual void process_post_operation(base_metric& delta, const operation_notification& o) override;
+
+    virtual void apply_delta(bucket_object& bucket, const base_metric& delta) override
+    {
+        bucket += delta;
+    }
 
-    virtual void process_pre_operation(const bucket_object& bucket, const operation_notification& o) override;
+    virtual void process_block_delta(const base_metric& delta) override;
 
-    virtual void process_post_operation(const bucket_object& bucket, const operation_notification& o) override;
+    uint32_t _timeline_resolution = 60;
+    uint32_t _timeline_history = 43200;
 };
 
 class operation_process
 {
 private:
     chain::database& _db;
-    const bucket_object& _bucket;
+    base_metric& _delta;
 
 public:
-    operation_process(chain::database& db, const bucket_object& b)
+    operation_process(chain::database& db, base_metric& delta)
         : _db(db)
-        , _bucket(b)
+        , _delta(delta)
     {
     }
 
@@ -68,96 +71,86 @@ public:
 
     void operator()(const transfer_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            b.transfers++;
+        _delta.transfers++;
 
-            if (op.amount.symbol() == SCORUM_SYMBOL)
-                b.scorum_transferred += op.amount.amount;
-        });
+        if (op.amount.symbol() == SCORUM_SYMBOL)
+            _delta.scorum_transferred += op.amount.amount;
     }
 
     void operator()(const account_create_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) { b.paid_accounts_created++; });
+        _delta.paid_accounts_created++;
     }
 
     void operator()(const account_create_with_delegation_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) { b.paid_accounts_created++; });
+        _delta.paid_accounts_created++;
     }
 
     void operator()(const account_create_by_committee_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) { b.free_accounts_created++; });
+        _delta.free_accounts_created++;
     }
 
     void operator()(const comment_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            auto& comment = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
-
-            if (comment.created == _db.head_block_time())
-            {
-                if (comment.parent_author.length())
-                    b.replies++;
-                else
-                    b.root_comments++;
-            }
+        auto& comment = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+
+        if (comment.created == _db.head_block_time())
+        {
+            if (comment.parent_author.length())
+                _delta.replies++;
             else
-            {
-                if (comment.parent_author.length())
-                    b.reply_edits++;
-                else
-                    b.root_comment_edits++;
-            }
-        });
+                _delta.root_comments++;
+        }
+        else
+        {
+            if (comment.parent_author.length())
+                _delta.reply_edits++;
+            else
+                _delta.root_comment_edits++;
+        }
     }
 
     void operator()(const vote_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            const auto& cv_idx = _db.get_index<comment_vote_index>().indices().get<by_comment_voter>();
-            const auto& comment = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
-            const auto& voter = _db.obtain_service<chain::dbs_account>().get_account(op.voter);
-            const auto itr = cv_idx.find(boost::make_tuple(comment.id, voter.id));
-
-            if (itr->num_changes)
-            {
-                if (comment.parent_author.size())
-                    b.new_reply_votes++;
-                else
-                    b.new_root_votes++;
-            }
+        const auto& cv_idx = _db.get_index<comment_vote_index>().indices().get<by_comment_voter>();
+        const auto& comment = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+        const auto& voter = _db.obtain_service<chain::dbs_account>().get_account(op.voter);
+        const auto itr = cv_idx.find(boost::make_tuple(comment.id, voter.id));
+
+        if (itr->num_changes)
+        {
+            if (comment.parent_author.size())
+                _delta.new_reply_votes++;
             else
-            {
-                if (comment.parent_author.size())
-                    b.changed_reply_votes++;
-                else
-                    b.changed_root_votes++;
-            }
-        });
+                _delta.new_root_votes++;
+        }
+        else
+        {
+            if (comment.parent_author.size())
+                _delta.changed_reply_votes++;
+            else
+                _delta.changed_root_votes++;
+        }
     }
 
     void operator()(const author_reward_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            b.payouts++;
-            b.scr_paid_to_authors += op.scorum_payout.amount;
-            b.scorumpower_paid_to_authors += op.vesting_payout.amount;
-        });
+        _delta.payouts++;
+        _delta.scr_paid_to_authors += op.scorum_payout.amount;
+        _delta.scorumpower_paid_to_authors += op.vesting_payout.amount;
     }
 
     void operator()(const curation_reward_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) { b.scorumpower_paid_to_curators += op.reward.amount; });
+        _delta.scorumpower_paid_to_curators += op.reward.amount;
     }
 
     void operator()(const transfer_to_scorumpower_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            b.transfers_to_scorumpower++;
-            b.scorum_transferred_to_scorumpower += op.amount.amount;
-        });
+        _delta.transfers_to_scorumpower++;
+        _delta.scorum_transferred_to_scorumpower += op.amount.amount;
     }
 
     void operator()(const fill_vesting_withdraw_operation& op) const
@@ -177,30 +170,25 @@ public:
             vesting_withdraw_rate = wvo.vesting_withdraw_rate;
         }
 
-        _db.modify(_bucket, [&](bucket_object& b) {
+        _delta.vesting_withdrawals_processed++;
 
-            b.vesting_withdrawals_processed++;
-
-            if (op.withdrawn.symbol() == SCORUM_SYMBOL)
-                b.scorumpower_withdrawn += op.withdrawn.amount;
-            else
-                b.scorumpower_transferred += op.withdrawn.amount;
+        if (op.withdrawn.symbol() == SCORUM_SYMBOL)
+            _delta.scorumpower_withdrawn += op.withdrawn.amount;
+        else
+            _delta.scorumpower_transferred += op.withdrawn.amount;
 
-            if (withdrawn.amount + op.withdrawn.amount >= to_withdraw.amount
-                || account.scorumpower.amount - op.withdrawn.amount == 0)
-            {
-                b.finished_vesting_withdrawals++;
+        if (withdrawn.amount + op.withdrawn.amount >= to_withdraw.amount
+            || account.scorumpower.amount - op.withdrawn.amount == 0)
+        {
+            _delta.finished_vesting_withdrawals++;
 
-                b.vesting_withdraw_rate_delta -= vesting_withdraw_rate.amount;
-            }
-        });
+            _delta.vesting_withdraw_rate_delta -= vesting_withdraw_rate.amount;
+        }
     }
 };
 
-void blockchain_statistics_plugin_impl::process_block(const bucket_object& bucket, const signed_block& b)
+void blockchain_statistics_plugin_impl::process_block(base_metric& delta, const signed_block& b)
 {
-    auto& db = _self.database();
-
     uint32_t trx_size = 0;
     uint32_t num_trx = b.transactions.size();
 
@@ -209,29 +197,63 @@ void blockchain_statistics_plugin_impl::process_block(const bucket_object& bucke
         trx_size += fc::raw::pack_size(trx);
     }
 
-    db.modify(bucket, [&](bucket_object& bo) {
-        bo.blocks++;
-        bo.transactions += num_trx;
-        bo.bandwidth += trx_size;
-    });
+    delta.blocks++;
+    delta.transactions += num_trx;
+    delta.bandwidth += trx_size;
+}
+
+void blockchain_statistics_plugin_impl::process_block_delta(const base_metric& delta)
+{
+    if (_timeline_resolution == 0)
+        return;
+
+    auto& db = _self.database();
+
+    auto open = fc::time_point_sec((db.head_block_time().sec_since_epoch() / _timeline_resolution)
+                                   * _timeline_resolution);
+
+    const auto& timeline_idx = db.get_index<timeline_index>().indices().get<by_open>();
+
+    auto itr = timeline_idx.find(open);
+    if (itr != timeline_idx.end())
+    {
+        db.modify(*itr, [&](timeline_object& t) { t += delta; });
+    }
+    else
+    {
+        base_metric cumulative;
+        if (!timeline_idx.empty())
+            cumulative = *timeline_idx.rbegin();
+
+        cumulative += delta;
+
+        db.create<timeline_object>([&](timeline_object& t) {
+            static_cast<base_metric&>(t) = cumulative;
+            t.open = open;
+        });
+
+        // checkpoints are absolute totals, the oldest ones can be dropped without changing the others
+        if (_timeline_history > 0)
+        {
+            while (timeline_idx.size() > _timeline_history)
+                db.remove(*timeline_idx.begin());
+        }
+    }
 }
 
-void blockchain_statistics_plugin_impl::process_pre_operation(const bucket_object& bucket,
-                                                              const operation_notification& o)
+void blockchain_statistics_plugin_impl::process_pre_operation(base_metric& delta, const operation_notification& o)
 {
     auto& db = _self.database();
 
     if (o.op.which() == operation::tag<delete_comment_operation>::value)
     {
         delete_comment_operation op = o.op.get<delete_comment_operation>();
-        auto comment = db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+        const auto& comment = db.obtain_service<dbs_comment>().get(op.author, op.permlink);
 
-        db.modify(bucket, [&](bucket_object& b) {
-            if (comment.parent_author.length())
-                b.replies_deleted++;
-            else
-                b.root_comments_deleted++;
-        });
+        if (comment.parent_author.length())
+            delta.replies_deleted++;
+        else
+            delta.root_comments_deleted++;
     }
     else if (o.op.which() == operation::tag<withdraw_scorumpower_operation>::value)
     {
@@ -252,27 +274,24 @@ void blockchain_statistics_plugin_impl::process_pre_operation(const bucket_objec
             vesting_withdraw_rate = wvo.vesting_withdraw_rate;
         }
 
-        db.modify(bucket, [&](bucket_object& b) {
-            if (vesting_withdraw_rate.amount > 0)
-                b.modified_vesting_withdrawal_requests++;
-            else
-                b.new_vesting_withdrawal_requests++;
+        if (vesting_withdraw_rate.amount > 0)
+            delta.modified_vesting_withdrawal_requests++;
+        else
+            delta.new_vesting_withdrawal_requests++;
 
-            b.vesting_withdraw_rate_delta += new_vesting_withdrawal_rate - vesting_withdraw_rate.amount;
-        });
+        delta.vesting_withdraw_rate_delta += new_vesting_withdrawal_rate - vesting_withdraw_rate.amount;
     }
 }
 
-void blockchain_statistics_plugin_impl::process_post_operation(const bucket_object& bucket,
-                                                               const operation_notification& o)
+void blockchain_statistics_plugin_impl::process_post_operation(base_metric& delta, const operation_notification& o)
 {
     auto& db = _self.database();
 
     if (!is_virtual_operation(o.op))
     {
-        db.modify(bucket, [&](bucket_object& b) { b.operations++; });
+        delta.operations++;
     }
-    o.op.visit(operation_process(db, bucket));
+    o.op.visit(operation_process(db, delta));
 }
 
 } // detail
@@ -281,6 +300,7 @@ blockchain_statistics_plugin::blockchain_statistics_plugin(application* app)
     : plugin(app)
     , _my(new detail::blockchain_statistics_plugin_impl(*this))
 {
+    database().add_plugin_index<timeline_index>();
 }
 
 blockchain_statistics_plugin::~blockchain_statistics_plugin()
@@ -296,7 +316,14 @@ void blockchain_statistics_plugin::plugin_set_program_options(boost::program_opt
         "Track blockchain statistics by grouping orders into buckets of equal size measured in seconds specified as a "
         "JSON array of numbers")(
         "chain-stats-history-per-bucket", boost::program_options::value<uint32_t>()->default_value(100),
-        "How far back in time to track history for each bucket size, measured in the number of buckets (default: 100)");
+        "How far back in time to track history for each bucket size, measured in the number of buckets (default: 100)")(
+        "chain-stats-timeline-resolution", boost::program_options::value<uint32_t>()->default_value(60),
+        "Resolution of the cumulative statistics timeline used for interval queries, measured in seconds. "
+        "0 disables the timeline (default: 60)")(
+        "chain-stats-timeline-history", boost::program_options::value<uint32_t>()->default_value(43200),
+        "How far back in time to keep the statistics timeline, measured in the number of checkpoints. Intervals "
+        "starting before the oldest checkpoint are aggregated from buckets. 0 keeps the whole timeline "
+        "(default: 43200)");
     cfg.add(cli);
 }
 
@@ -311,9 +338,15 @@ void blockchain_statistics_plugin::plugin_initialize(const boost::program_option
         }
         if (options.count("chain-stats-history-per-bucket"))
             _my->_maximum_history_per_bucket_size = options["chain-stats-history-per-bucket"].as<uint32_t>();
+        if (options.count("chain-stats-timeline-resolution"))
+            _my->_timeline_resolution = options["chain-stats-timeline-resolution"].as<uint32_t>();
+        if (options.count("chain-stats-timeline-history"))
+            _my->_timeline_history = options["chain-stats-timeline-history"].as<uint32_t>();
 
         ilog("chain-stats-bucket-size: ${b}", ("b", _my->_tracked_buckets));
         ilog("chain-stats-history-per-bucket: ${h}", ("h", _my->_maximum_history_per_bucket_size));
+        ilog("chain-stats-timeline-resolution: ${r}", ("r", _my->_timeline_resolution));
+        ilog("chain-stats-timeline-history: ${h}", ("h", _my->_timeline_history));
 
         dlog("chain_stats_plugin: plugin_initialize() end");
     }
@@ -339,6 +372,11 @@ uint32_t blockchain_statistics_plugin::get_max_history_per_bucket() const
 {
     return _my->_maximum_history_per_bucket_size;
 }
+
+uint32_t blockchain_statistics_plugin::get_timeline_resolution() const
+{
+    return _my->_timeline_resolution;
+}
 }
 } // scorum::blockchain_statistics
 
@@ -33,6 +33,10 @@ public:
 
     /**
      * @brief Aggregates statistics over a time interval.
+     *
+     * Uses the cumulative timeline when it is enabled and reaches back to start, so the bounds are rounded up to the
+     * timeline resolution. Otherwise the statistics are aggregated from buckets.
+     *
      * @param start The beginning time of the window.
      * @param stop The end time of the window. stop must take place after start.
      * @returns Aggregated statistics over the interval.
@@ -33,6 +33,7 @@ public:
 
     const flat_set<uint32_t>& get_tracked_buckets() const;
     uint32_t get_max_history_per_bucket() const;
+    uint32_t get_timeline_resolution() const;
 
 private:
     friend class detail::blockchain_statistics_plugin_impl;
@@ -17,7 +17,8 @@ using namespace scorum::chain;
 
 enum blockchain_statistics_object_type
 {
-    bucket_object_type = (BLOCKCHAIN_STATISTICS_SPACE_ID << 8)
+    bucket_object_type = (BLOCKCHAIN_STATISTICS_SPACE_ID << 8),
+    timeline_object_type
 };
 
 struct bucket_object : public common_statistics::base_bucket_object,
@@ -50,6 +51,34 @@ typedef shared_multi_index_container<bucket_object,
                                                                                     &common_statistics::
                                                                                         base_bucket_object::open>>>>>
     bucket_index;
+
+/**
+ * Running totals of all metrics for blocks with time before open + resolution. A checkpoint is created for every
+ * timeline resolution interval that has blocks, so statistics for any [start, end) interval are the difference of two
+ * checkpoints.
+ */
+struct timeline_object : public base_metric, public object<timeline_object_type, timeline_object>
+{
+    CHAINBASE_DEFAULT_CONSTRUCTOR(timeline_object)
+
+    id_type id;
+
+    fc::time_point_sec open; ///< Open time of the checkpoint interval
+};
+
+typedef oid<timeline_object> timeline_id_type;
+
+struct by_open;
+typedef shared_multi_index_container<timeline_object,
+                                     indexed_by<ordered_unique<tag<by_id>,
+                                                               member<timeline_object,
+                                                                      timeline_id_type,
+                                                                      &timeline_object::id>>,
+                                                ordered_unique<tag<by_open>,
+                                                               member<timeline_object,
+                                                                      fc::time_point_sec,
+                                                                      &timeline_object::open>>>>
+    timeline_index;
 } // namespace blockchain_statistics
 } // namespace scorum
 
@@ -58,3 +87,9 @@ FC_REFLECT_DERIVED(scorum::blockchain_statistics::bucket_object,
                    (id))
 
 CHAINBASE_SET_INDEX_TYPE(scorum::blockchain_statistics::bucket_object, scorum::blockchain_statistics::bucket_index)
+
+FC_REFLECT_DERIVED(scorum::blockchain_statistics::timeline_object,
+                   (scorum::blockchain_statistics::base_metric),
+                   (id)(open))
+
+CHAINBASE_SET_INDEX_TYPE(scorum::blockchain_statistics::timeline_object, scorum::blockchain_statistics::timeline_index)
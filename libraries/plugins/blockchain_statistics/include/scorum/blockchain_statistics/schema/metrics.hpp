@@ -47,6 +47,9 @@ struct base_metric
     share_type scr_paid_to_authors = 0; ///< Amount of SCR paid to authors
     share_type scorumpower_paid_to_authors = 0; ///< Amount of SP paid to authors
     share_type scorumpower_paid_to_curators = 0; ///< Amount of SP paid to curators
+
+    base_metric& operator+=(const base_metric&);
+    base_metric& operator-=(const base_metric&);
 };
 
 struct total_metric
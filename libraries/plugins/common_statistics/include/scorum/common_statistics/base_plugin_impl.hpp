@@ -15,7 +15,16 @@ using namespace scorum::chain;
 
 struct by_bucket;
 
-template <typename Bucket, typename Plugin> class common_statistics_plugin_impl
+/**
+ * Operations and blocks are accumulated into a process-local Metric delta while a block is applied. The delta is
+ * written to every tracked bucket once, when the block has been applied, so the cost of statistics does not depend on
+ * the number of operations in the block.
+ *
+ * The delta is dropped at the beginning of every block. Anything collected from pending transactions is discarded
+ * this way, and the buckets themselves are modified inside the block undo session, so pop_block reverts them as any
+ * other object.
+ */
+template <typename Bucket, typename Plugin, typename Metric> class common_statistics_plugin_impl
 {
     typedef typename chainbase::get_index_type<Bucket>::type bucket_index;
 
@@ -24,18 +33,24 @@ public:
 
     Plugin& _self;
     flat_set<uint32_t> _tracked_buckets = { 60, 3600, 21600, 86400, 604800, 2592000, LIFE_TIME_PERIOD };
-    flat_set<typename Bucket::id_type> _current_buckets;
     uint32_t _maximum_history_per_bucket_size = 100;
 
+    Metric _block_delta;
+
 public:
     common_statistics_plugin_impl(Plugin& plugin)
         : _self(plugin)
     {
         auto& db = _self.database();
 
-        db.applied_block.connect([&](const signed_block& b) { this->on_block(b); });
-        db.pre_apply_operation.connect([&](const operation_notification& o) { this->pre_operation(o); });
-        db.post_apply_operation.connect([&](const operation_notification& o) { this->post_operation(o); });
+        db.connect_plugin_handler(_self.plugin_name(), db.pre_apply_block,
+                                  [&](const signed_block& b) { this->on_pre_block(b); });
+        db.connect_plugin_handler(_self.plugin_name(), db.applied_block,
+                                  [&](const signed_block& b) { this->on_block(b); });
+        db.connect_plugin_handler(_self.plugin_name(), db.pre_apply_operation,
+                                  [&](const operation_notification& o) { this->pre_operation(o); });
+        db.connect_plugin_handler(_self.plugin_name(), db.post_apply_operation,
+                                  [&](const operation_notification& o) { this->post_operation(o); });
 
         db.template add_plugin_index<bucket_index>();
     }
@@ -46,40 +61,44 @@ public:
     virtual void process_bucket_creation(const Bucket& bucket)
     {
     }
-    virtual void process_block(const Bucket& bucket, const signed_block& b)
+    virtual void process_block(Metric& delta, const signed_block& b)
     {
     }
-    virtual void process_pre_operation(const Bucket& bucket, const operation_notification& o)
+    virtual void process_pre_operation(Metric& delta, const operation_notification& o)
     {
     }
-    virtual void process_post_operation(const Bucket& bucket, const operation_notification& o)
+    virtual void process_post_operation(Metric& delta, const operation_notification& o)
     {
     }
 
-    void pre_operation(const operation_notification& o)
+    /// adds accumulated delta to the bucket, called inside of db.modify
+    virtual void apply_delta(Bucket& bucket, const Metric& delta) = 0;
+
+    virtual bool is_empty(const Metric& delta) const
     {
-        auto& db = _self.database();
+        return false;
+    }
 
-        for (auto bucket_id : _current_buckets)
-        {
-            const auto& bucket = db.get(bucket_id);
+    /// called once per block with the delta of the block after it has been applied to the buckets
+    virtual void process_block_delta(const Metric& delta)
+    {
+    }
 
-            process_pre_operation(bucket, o);
-        }
+    void on_pre_block(const signed_block&)
+    {
+        _block_delta = Metric();
+    }
+
+    void pre_operation(const operation_notification& o)
+    {
+        process_pre_operation(_block_delta, o);
     }
 
     void post_operation(const operation_notification& o)
     {
         try
         {
-            auto& db = _self.database();
-
-            for (auto bucket_id : _current_buckets)
-            {
-                const auto& bucket = db.get(bucket_id);
-
-                process_post_operation(bucket, o);
-            }
+            process_post_operation(_block_delta, o);
         }
         FC_CAPTURE_AND_RETHROW()
     }
@@ -88,7 +107,7 @@ public:
     {
         auto& db = _self.database();
 
-        _current_buckets.clear();
+        process_block(_block_delta, block);
 
         const auto& bucket_idx = db.template get_index<bucket_index>().indices().get<common_statistics::by_bucket>();
 
@@ -97,11 +116,7 @@ public:
             auto open = fc::time_point_sec((db.head_block_time().sec_since_epoch() / bucket) * bucket);
 
             auto itr = bucket_idx.find(boost::make_tuple(bucket, open));
-            if (itr != bucket_idx.end())
-            {
-                _current_buckets.insert(itr->id);
-            }
-            else
+            if (itr == bucket_idx.end())
             {
                 const auto& new_bucket_obj = db.template create<Bucket>([&](Bucket& bo) {
                     bo.open = open;
@@ -110,8 +125,6 @@ public:
 
                 process_bucket_creation(new_bucket_obj);
 
-                _current_buckets.insert(new_bucket_obj.id);
-
                 // adjust history
                 if (_maximum_history_per_bucket_size > 0)
                 {
@@ -127,13 +140,13 @@ public:
                                     .value);
                         }
 
-                        itr = bucket_idx.lower_bound(boost::make_tuple(bucket, fc::time_point_sec()));
+                        auto old_itr = bucket_idx.lower_bound(boost::make_tuple(bucket, fc::time_point_sec()));
 
-                        while (itr->seconds == bucket && itr->open < cutoff)
+                        while (old_itr->seconds == bucket && old_itr->open < cutoff)
                         {
-                            auto old_itr = itr;
-                            ++itr;
-                            db.remove(*old_itr);
+                            const auto& old_bucket = *old_itr;
+                            ++old_itr;
+                            db.remove(old_bucket);
                         }
                     }
                     catch (fc::overflow_exception& e)
@@ -143,10 +156,19 @@ public:
                     {
                     }
                 }
+
+                itr = bucket_idx.iterator_to(new_bucket_obj);
             }
 
-            process_block(*itr, block);
+            if (!is_empty(_block_delta))
+            {
+                db.modify(*itr, [&](Bucket& bo) { apply_delta(bo, _block_delta); });
+            }
         }
+
+        process_block_delta(_block_delta);
+
+        _block_delta = Metric();
     }
 };
 
@@ -55,7 +55,8 @@ void debug_node_plugin::plugin_startup()
     chain::database& db = database();
 
     // connect needed signals
-    _applied_block_conn = db.applied_block.connect([this](const chain::signed_block& b) { on_applied_block(b); });
+    _applied_block_conn = db.connect_plugin_handler(plugin_name(), db.applied_block,
+                                                    [this](const chain::signed_block& b) { on_applied_block(b); });
 
     app().register_api_factory<debug_node_api>("debug_node_api");
 }
@@ -46,7 +46,8 @@ enum
     tag_object_type = (TAG_SPACE_ID << 8),
     tag_stats_object_type,
     peer_stats_object_type,
-    author_tag_stats_object_type
+    author_tag_stats_object_type,
+    comment_tags_object_type
 };
 
 namespace detail {
@@ -411,6 +412,46 @@ typedef shared_multi_index_container<
     author_tag_stats_index;
 // clang-format on
 
+/**
+ *  Keeps the normalized (lower-cased, deduplicated and limited) tag set of a comment as it was parsed from
+ *  json_metadata when the comment was created or last edited. Everything that needs the tags of a comment reads them
+ *  from here so json_metadata is parsed once per change of metadata only.
+ *
+ *  The universal (empty) tag is not stored because it depends on net_rshares and is added on read.
+ */
+class comment_tags_object : public object<comment_tags_object_type, comment_tags_object>
+{
+public:
+    CHAINBASE_DEFAULT_DYNAMIC_CONSTRUCTOR(comment_tags_object, (tags))
+
+    id_type id;
+
+    account_name_type author;
+    comment_id_type comment;
+
+    /// sorted in ascending order
+    fc::shared_vector<tag_name_type> tags;
+};
+
+typedef oid<comment_tags_object> comment_tags_id_type;
+
+// clang-format off
+typedef shared_multi_index_container<
+    comment_tags_object,
+    indexed_by<
+        ordered_unique<tag<by_id>,
+                       member<comment_tags_object, comment_tags_id_type, &comment_tags_object::id>>,
+        ordered_unique<tag<by_comment>,
+                       member<comment_tags_object, comment_id_type, &comment_tags_object::comment>>,
+        ordered_unique<tag<by_author_comment>,
+                       composite_key<comment_tags_object,
+                                     member<comment_tags_object, account_name_type, &comment_tags_object::author>,
+                                     member<comment_tags_object, comment_id_type, &comment_tags_object::comment>>,
+                       composite_key_compare<std::less<account_name_type>, std::less<comment_id_type>>>>
+    >
+    comment_tags_index;
+// clang-format on
+
 /**
  * Used to parse the metadata from the comment json_meta field.
  */
@@ -488,4 +529,7 @@ FC_REFLECT(scorum::tags::comment_metadata, (tags))
 FC_REFLECT(scorum::tags::author_tag_stats_object, (id)(author)(tag)(total_posts)(total_rewards))
 CHAINBASE_SET_INDEX_TYPE( scorum::tags::author_tag_stats_object, scorum::tags::author_tag_stats_index)
 
+FC_REFLECT(scorum::tags::comment_tags_object, (id)(author)(comment)(tags))
+CHAINBASE_SET_INDEX_TYPE( scorum::tags::comment_tags_object, scorum::tags::comment_tags_index)
+
 // clang-format on
@@ -117,7 +117,7 @@ struct operation_visitor
         return _db.create<tag_stats_object>([&](tag_stats_object& stats) { stats.tag = tag; });
     }
 
-    comment_metadata filter_tags(const comment_object& c) const
+    comment_metadata parse_tags(const comment_object& c) const
     {
         comment_metadata meta;
 
@@ -150,14 +150,64 @@ struct operation_visitor
             lower_tags.insert(fc::to_lower(tag));
         }
 
+        meta.tags = std::move(lower_tags);
+
+        return meta;
+    }
+
+    const comment_tags_object* find_comment_tags(const comment_object& c) const
+    {
+        const auto& idx = _db.get_index<comment_tags_index>().indices().get<by_comment>();
+        auto itr = idx.find(c.id);
+        if (itr != idx.end())
+            return &(*itr);
+
+        return nullptr;
+    }
+
+    /// parses json_metadata of the comment and caches the result
+    const comment_tags_object& update_comment_tags(const comment_object& c) const
+    {
+        comment_metadata meta = parse_tags(c);
+
+        auto assign_tags = [&](comment_tags_object& obj) {
+            obj.tags.clear();
+            obj.tags.reserve(meta.tags.size());
+            for (const std::string& tag : meta.tags)
+                obj.tags.push_back(tag_name_type(tag));
+        };
+
+        const comment_tags_object* cached = find_comment_tags(c);
+        if (cached != nullptr)
+        {
+            _db.modify(*cached, assign_tags);
+            return *cached;
+        }
+
+        return _db.create<comment_tags_object>([&](comment_tags_object& obj) {
+            obj.author = c.author;
+            obj.comment = c.id;
+            assign_tags(obj);
+        });
+    }
+
+    comment_metadata filter_tags(const comment_object& c) const
+    {
+        comment_metadata meta;
+
+        const comment_tags_object* cached = find_comment_tags(c);
+        if (cached == nullptr)
+            cached = &update_comment_tags(c);
+
+        for (const tag_name_type& tag : cached->tags)
+            meta.tags.insert(meta.tags.end(), std::string(tag));
+
         /// the universal tag applies to everything safe for work or nsfw with a non-negative payout
         if (c.net_rshares >= 0)
         {
-            lower_tags.insert(std::string()); /// add it to the universal tag
+            meta.tags.insert(std::string()); /// add it to the universal tag
         }
 
-        meta.tags = lower_tags; /// TODO: std::move???
-
         return meta;
     }
 
@@ -388,7 +438,13 @@ struct operation_visitor
 
     void operator()(const comment_operation& op) const
     {
-        update_tags(_db.obtain_service<dbs_comment>().get(op.author, op.permlink), true);
+        const auto& c = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+
+        // json_metadata of the comment is left untouched by edits that do not carry it
+        if (op.json_metadata.size() || find_comment_tags(c) == nullptr)
+            update_comment_tags(c);
+
+        update_tags(c, true);
     }
 
     void operator()(const transfer_operation& op) const
@@ -459,6 +515,18 @@ struct operation_visitor
                 _db.remove(tobj);
             }
         }
+
+        const auto& cached_idx = _db.get_index<comment_tags_index>().indices().get<by_author_comment>();
+        auto citr = cached_idx.lower_bound(boost::make_tuple(op.author));
+        while (citr != cached_idx.end() && citr->author == op.author)
+        {
+            const auto& cached = *citr;
+            ++citr;
+            if (!_db.find<comment_object>(cached.comment))
+            {
+                _db.remove(cached);
+            }
+        }
     }
 
     void operator()(const comment_reward_operation& op) const
@@ -487,6 +555,13 @@ struct operation_visitor
 
 void tags_plugin_impl::on_operation(const operation_notification& note)
 {
+    static const operation_mask handled_operations
+        = make_operation_mask<comment_operation, transfer_operation, vote_operation, delete_comment_operation,
+                              comment_reward_operation, comment_payout_update_operation>();
+
+    if (!handled_operations.test(note.op.which()))
+        return;
+
     try
     {
         /// plugins shouldn't ever throw
@@ -514,6 +589,7 @@ tags_plugin::tags_plugin(application* app)
     db.add_plugin_index<tag_stats_index>();
     db.add_plugin_index<peer_stats_index>();
     db.add_plugin_index<author_tag_stats_index>();
+    db.add_plugin_index<comment_tags_index>();
 }
 
 tags_plugin::~tags_plugin()
@@ -527,7 +603,8 @@ void tags_plugin::plugin_set_program_options(boost::program_options::options_des
 
 void tags_plugin::plugin_initialize(const boost::program_options::variables_map& options)
 {
-    database().post_apply_operation.connect([&](const operation_notification& note) { my->on_operation(note); });
+    database().connect_plugin_handler(plugin_name(), database().post_apply_operation,
+                                      [&](const operation_notification& note) { my->on_operation(note); });
 
     app().register_api_factory<tag_api>("tag_api");
 
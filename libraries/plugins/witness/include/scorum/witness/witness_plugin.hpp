@@ -25,6 +25,7 @@
 
 #include <scorum/app/plugin.hpp>
 #include <scorum/chain/database/database.hpp>
+#include <scorum/witness/witness_objects.hpp>
 
 #include <fc/thread/future.hpp>
 #include <fc/api.hpp>
@@ -59,6 +60,13 @@ namespace detail {
 class witness_plugin_impl;
 }
 
+struct account_bandwidth_state
+{
+    share_type average_bandwidth;
+    share_type lifetime_bandwidth;
+    time_point_sec last_bandwidth_update;
+};
+
 class witness_plugin : public scorum::app::plugin
 {
 public:
@@ -79,6 +87,9 @@ public:
     virtual void plugin_startup() override;
     virtual void plugin_shutdown() override;
 
+    /// current bandwidth of the account, including reversible blocks and pending transactions
+    account_bandwidth_state get_account_bandwidth(const account_name_type& account, bandwidth_type type) const;
+
 private:
     void schedule_production_loop();
     void block_production_loop();
@@ -39,8 +39,11 @@
 #include <fc/smart_ref_impl.hpp>
 #include <fc/thread/thread.hpp>
 
+#include <array>
+#include <deque>
 #include <iostream>
 #include <memory>
+#include <unordered_map>
 
 #define DISTANCE_CALC_PRECISION (10000)
 
@@ -55,6 +58,46 @@ using chain::account_object;
 namespace detail {
 using namespace scorum::chain;
 
+enum bandwidth_slot
+{
+    forum_slot = 0,
+    market_slot,
+    bandwidth_slots_count
+};
+
+inline bandwidth_type slot_bandwidth_type(size_t slot)
+{
+    return slot == market_slot ? bandwidth_type::market : bandwidth_type::forum;
+}
+
+inline size_t bandwidth_type_slot(bandwidth_type type)
+{
+    FC_ASSERT(type == bandwidth_type::forum || type == bandwidth_type::market, "Bandwidth type is not tracked.");
+    return type == bandwidth_type::market ? market_slot : forum_slot;
+}
+
+struct account_bandwidth_record
+{
+    account_name_type account;
+    std::array<account_bandwidth_state, bandwidth_slots_count> bandwidth;
+
+    /// bit mask of slots changed by the layer, slots that are not set are taken from the layers below
+    uint8_t changed = 0;
+};
+
+/**
+ * Bandwidth changed by one block (or by pending transactions), keyed by account id.
+ */
+struct bandwidth_layer
+{
+    uint32_t block_num = 0;
+
+    /// number of the block which wrote this layer to account_bandwidth_index, zero if it has not been written yet
+    uint32_t written_in = 0;
+
+    std::unordered_map<int64_t, account_bandwidth_record> accounts;
+};
+
 class witness_plugin_impl
 {
 public:
@@ -67,11 +110,27 @@ public:
 
     void pre_transaction(const signed_transaction& trx);
     void pre_operation(const operation_notification& note);
+    void pre_block(const signed_block& b);
     void on_block(const signed_block& b);
+    void clear_pending();
 
-    void update_account_bandwidth(const account_object& a, uint32_t trx_size, const bandwidth_type type);
+    account_bandwidth_state get_bandwidth(const account_object& a, size_t slot) const;
+    void write_bandwidth(const bandwidth_layer& layer);
+    void commit_bandwidth(const signed_block& b);
 
     witness_plugin& _self;
+
+    /**
+     * Bandwidth is tracked in process and account_bandwidth_index holds only the irreversible part of it.
+     *
+     * _pending collects pending transactions and the transactions of the block being applied. It is dropped whenever
+     * the database throws the pending state away (pending transactions are applied again after that, so keeping it
+     * would charge them twice) and before a block is applied, and becomes a reversible layer once the block has been
+     * applied. Reversible layers are written to the database when their block becomes irreversible and are kept
+     * until the block that wrote them is irreversible too, so popping blocks never loses bandwidth.
+     */
+    bandwidth_layer _pending;
+    std::deque<bandwidth_layer> _reversible;
 };
 
 void witness_plugin_impl::plugin_initialize()
@@ -198,38 +257,135 @@ struct operation_visitor
 void witness_plugin_impl::pre_transaction(const signed_transaction& trx)
 {
     const auto& _db = _self.database();
+    const auto& props = _db.obtain_service<dbs_dynamic_global_property>().get();
+
+    if (props.total_scorumpower.amount <= 0)
+        return;
+
     flat_set<account_name_type> required;
     std::vector<authority> other;
     trx.get_required_authorities(required, required, required, other);
 
-    auto trx_size = fc::raw::pack_size(trx);
+    share_type trx_size = fc::raw::pack_size(trx);
+
+    std::array<share_type, bandwidth_slots_count> trx_bandwidth;
+    trx_bandwidth[forum_slot] = trx_size * SCORUM_BANDWIDTH_PRECISION;
+    trx_bandwidth[market_slot] = 0;
+
+    for (const auto& op : trx.operations)
+    {
+        if (is_market_operation(op))
+        {
+            trx_bandwidth[market_slot] = trx_size * 10 * SCORUM_BANDWIDTH_PRECISION;
+            break;
+        }
+    }
+
+    const auto now = _db.head_block_time();
+    fc::uint128 total_vshares(props.total_scorumpower.amount.value);
+    fc::uint128 max_virtual_bandwidth(_db.get(reserve_ratio_id_type()).max_virtual_bandwidth);
+
+    // all accounts are checked before anything is recorded, so a rejected transaction leaves no trace
+    std::vector<std::pair<int64_t, account_bandwidth_record>> updates;
+    updates.reserve(required.size());
 
     for (const auto& auth : required)
     {
         const auto& acnt = _db.obtain_service<dbs_account>().get_account(auth);
+        fc::uint128 account_vshares(acnt.effective_scorumpower().amount.value);
 
-        update_account_bandwidth(acnt, trx_size, bandwidth_type::forum);
+        account_bandwidth_record record;
+        record.account = acnt.name;
 
-        for (const auto& op : trx.operations)
+        for (size_t slot = 0; slot < bandwidth_slots_count; ++slot)
         {
-            if (is_market_operation(op))
+            if (trx_bandwidth[slot] == 0)
+                continue;
+
+            auto& band = record.bandwidth[slot];
+            band = get_bandwidth(acnt, slot);
+
+            auto delta_time = (now - band.last_bandwidth_update).to_seconds();
+
+            if (delta_time > SCORUM_BANDWIDTH_AVERAGE_WINDOW_SECONDS)
             {
-                update_account_bandwidth(acnt, trx_size * 10, bandwidth_type::market);
-                break;
+                band.average_bandwidth = 0;
             }
+            else
+                band.average_bandwidth
+                    = (((SCORUM_BANDWIDTH_AVERAGE_WINDOW_SECONDS - delta_time) * fc::uint128(band.average_bandwidth.value))
+                       / SCORUM_BANDWIDTH_AVERAGE_WINDOW_SECONDS)
+                          .to_uint64();
+
+            band.average_bandwidth += trx_bandwidth[slot];
+            band.lifetime_bandwidth += trx_bandwidth[slot];
+            band.last_bandwidth_update = now;
+            record.changed |= (1 << slot);
+
+            fc::uint128 account_average_bandwidth(band.average_bandwidth.value);
+
+            bool has_bandwidth = (account_vshares * max_virtual_bandwidth) > (account_average_bandwidth * total_vshares);
+
+            if (_db.is_producing())
+                SCORUM_ASSERT(has_bandwidth, chain::plugin_exception,
+                              "Account: ${account} bandwidth limit exceeded. Please wait to transact or power up SCR.",
+                              ("account", acnt.name)("account_vshares", account_vshares)(
+                                  "account_average_bandwidth", account_average_bandwidth)(
+                                  "max_virtual_bandwidth", max_virtual_bandwidth)("total_scorumpower", total_vshares));
         }
+
+        updates.emplace_back(acnt.id._id, std::move(record));
+    }
+
+    for (const auto& update : updates)
+    {
+        auto& record = _pending.accounts[update.first];
+        record.account = update.second.account;
+
+        for (size_t slot = 0; slot < bandwidth_slots_count; ++slot)
+        {
+            if (update.second.changed & (1 << slot))
+                record.bandwidth[slot] = update.second.bandwidth[slot];
+        }
+
+        record.changed |= update.second.changed;
     }
 }
 
 void witness_plugin_impl::pre_operation(const operation_notification& note)
 {
+    static const operation_mask checked_operations
+        = make_operation_mask<comment_options_operation, comment_operation, transfer_operation>();
+
     const auto& _db = _self.database();
-    if (_db.is_producing())
+    if (_db.is_producing() && checked_operations.test(note.op.which()))
     {
         note.op.visit(operation_visitor(_db));
     }
 }
 
+void witness_plugin_impl::clear_pending()
+{
+    _pending = bandwidth_layer();
+}
+
+void witness_plugin_impl::pre_block(const signed_block& b)
+{
+    clear_pending();
+
+    // layers of popped blocks are dropped, as are the writes those blocks made to the database
+    const uint32_t block_num = b.block_num();
+
+    while (!_reversible.empty() && _reversible.back().block_num >= block_num)
+        _reversible.pop_back();
+
+    for (auto& layer : _reversible)
+    {
+        if (layer.written_in >= block_num)
+            layer.written_in = 0;
+    }
+}
+
 void witness_plugin_impl::on_block(const signed_block& b)
 {
     auto& db = _self.database();
@@ -309,63 +465,104 @@ void witness_plugin_impl::on_block(const signed_block& b)
             }
         });
     }
+
+    commit_bandwidth(b);
+}
+
+account_bandwidth_state witness_plugin_impl::get_bandwidth(const account_object& a, size_t slot) const
+{
+    auto itr = _pending.accounts.find(a.id._id);
+    if (itr != _pending.accounts.end() && (itr->second.changed & (1 << slot)))
+        return itr->second.bandwidth[slot];
+
+    for (auto layer = _reversible.rbegin(); layer != _reversible.rend(); ++layer)
+    {
+        itr = layer->accounts.find(a.id._id);
+        if (itr != layer->accounts.end() && (itr->second.changed & (1 << slot)))
+            return itr->second.bandwidth[slot];
+    }
+
+    account_bandwidth_state result;
+
+    auto band = _self.database().find<account_bandwidth_object, by_account_bandwidth_type>(
+        boost::make_tuple(a.name, slot_bandwidth_type(slot)));
+
+    if (band != nullptr)
+    {
+        result.average_bandwidth = band->average_bandwidth;
+        result.lifetime_bandwidth = band->lifetime_bandwidth;
+        result.last_bandwidth_update = band->last_bandwidth_update;
+    }
+
+    return result;
 }
 
-void witness_plugin_impl::update_account_bandwidth(const account_object& a,
-                                                   uint32_t trx_size,
-                                                   const bandwidth_type type)
+void witness_plugin_impl::write_bandwidth(const bandwidth_layer& layer)
 {
     database& _db = _self.database();
-    const auto& props = _db.obtain_service<dbs_dynamic_global_property>().get();
-    bool has_bandwidth = true;
 
-    if (props.total_scorumpower.amount > 0)
+    for (const auto& item : layer.accounts)
     {
-        auto band = _db.find<account_bandwidth_object, by_account_bandwidth_type>(boost::make_tuple(a.name, type));
+        const auto& record = item.second;
 
-        if (band == nullptr)
+        for (size_t slot = 0; slot < bandwidth_slots_count; ++slot)
         {
-            band = &_db.create<account_bandwidth_object>([&](account_bandwidth_object& b) {
-                b.account = a.name;
-                b.type = type;
-            });
-        }
+            if (!(record.changed & (1 << slot)))
+                continue;
 
-        share_type new_bandwidth;
-        share_type trx_bandwidth = trx_size * SCORUM_BANDWIDTH_PRECISION;
-        auto delta_time = (_db.head_block_time() - band->last_bandwidth_update).to_seconds();
+            const auto type = slot_bandwidth_type(slot);
+            const auto& state = record.bandwidth[slot];
 
-        if (delta_time > SCORUM_BANDWIDTH_AVERAGE_WINDOW_SECONDS)
-        {
-            new_bandwidth = 0;
+            auto band
+                = _db.find<account_bandwidth_object, by_account_bandwidth_type>(boost::make_tuple(record.account, type));
+
+            if (band == nullptr)
+            {
+                band = &_db.create<account_bandwidth_object>([&](account_bandwidth_object& b) {
+                    b.account = record.account;
+                    b.type = type;
+                });
+            }
+
+            _db.modify(*band, [&](account_bandwidth_object& b) {
+                b.average_bandwidth = state.average_bandwidth;
+                b.lifetime_bandwidth = state.lifetime_bandwidth;
+                b.last_bandwidth_update = state.last_bandwidth_update;
+            });
         }
-        else
-            new_bandwidth
-                = (((SCORUM_BANDWIDTH_AVERAGE_WINDOW_SECONDS - delta_time) * fc::uint128(band->average_bandwidth.value))
-                   / SCORUM_BANDWIDTH_AVERAGE_WINDOW_SECONDS)
-                      .to_uint64();
+    }
+}
 
-        new_bandwidth += trx_bandwidth;
+void witness_plugin_impl::commit_bandwidth(const signed_block& b)
+{
+    const auto& _db = _self.database();
+    const uint32_t block_num = b.block_num();
 
-        _db.modify(*band, [&](account_bandwidth_object& b) {
-            b.average_bandwidth = new_bandwidth;
-            b.lifetime_bandwidth += trx_bandwidth;
-            b.last_bandwidth_update = _db.head_block_time();
-        });
+    if (!_pending.accounts.empty())
+    {
+        _pending.block_num = block_num;
+        _reversible.emplace_back(std::move(_pending));
+    }
+    _pending = bandwidth_layer();
 
-        fc::uint128 account_vshares(a.effective_scorumpower().amount.value);
-        fc::uint128 total_vshares(props.total_scorumpower.amount.value);
-        fc::uint128 account_average_bandwidth(band->average_bandwidth.value);
-        fc::uint128 max_virtual_bandwidth(_db.get(reserve_ratio_id_type()).max_virtual_bandwidth);
+    const uint32_t last_irreversible_block_num = _db.get_last_irreversible_block_num();
 
-        has_bandwidth = (account_vshares * max_virtual_bandwidth) > (account_average_bandwidth * total_vshares);
+    for (auto& layer : _reversible)
+    {
+        if (layer.block_num > last_irreversible_block_num)
+            break;
 
-        if (_db.is_producing())
-            SCORUM_ASSERT(has_bandwidth, chain::plugin_exception,
-                          "Account: ${account} bandwidth limit exceeded. Please wait to transact or power up SCR.",
-                          ("account", a.name)("account_vshares", account_vshares)("account_average_bandwidth",
-                                                                                  account_average_bandwidth)(
-                              "max_virtual_bandwidth", max_virtual_bandwidth)("total_scorumpower", total_vshares));
+        if (layer.written_in == 0)
+        {
+            write_bandwidth(layer);
+            layer.written_in = block_num;
+        }
+    }
+
+    while (!_reversible.empty() && _reversible.front().written_in != 0
+           && _reversible.front().written_in <= last_irreversible_block_num)
+    {
+        _reversible.pop_front();
     }
 }
 }
@@ -413,6 +610,13 @@ void witness_plugin::plugin_set_program_options(boost::program_options::options_
     config_file_options.add(command_line_options);
 }
 
+account_bandwidth_state witness_plugin::get_account_bandwidth(const account_name_type& account,
+                                                              bandwidth_type type) const
+{
+    const auto& acnt = app().chain_database()->obtain_service<chain::dbs_account>().get_account(account);
+    return _my->get_bandwidth(acnt, detail::bandwidth_type_slot(type));
+}
+
 std::string witness_plugin::plugin_name() const
 {
     return "witness";
@@ -438,9 +642,13 @@ void witness_plugin::plugin_initialize(const boost::program_options::variables_m
 
         chain::database& db = database();
 
-        db.on_pre_apply_transaction.connect([&](const signed_transaction& tx) { _my->pre_transaction(tx); });
-        db.pre_apply_operation.connect([&](const operation_notification& note) { _my->pre_operation(note); });
-        db.applied_block.connect([&](const signed_block& b) { _my->on_block(b); });
+        db.connect_plugin_handler(plugin_name(), db.on_pre_apply_transaction,
+                                  [&](const signed_transaction& tx) { _my->pre_transaction(tx); });
+        db.connect_plugin_handler(plugin_name(), db.pre_apply_operation,
+                                  [&](const operation_notification& note) { _my->pre_operation(note); });
+        db.connect_plugin_handler(plugin_name(), db.pre_apply_block, [&](const signed_block& b) { _my->pre_block(b); });
+        db.connect_plugin_handler(plugin_name(), db.applied_block, [&](const signed_block& b) { _my->on_block(b); });
+        db.on_clear_pending.connect([&]() { _my->clear_pending(); });
 
         db.add_plugin_index<account_bandwidth_index>();
         db.add_plugin_index<reserve_ratio_index>();
@@ -4,6 +4,11 @@
 #include <scorum/protocol/scorum_operations.hpp>
 #include <scorum/protocol/scorum_virtual_operations.hpp>
 
+#include <array>
+#include <bitset>
+#include <string>
+#include <type_traits>
+
 namespace scorum {
 namespace protocol {
 
@@ -77,6 +82,77 @@ void operation_validate( const operation& op );*/
 bool is_market_operation(const operation& op);
 
 bool is_virtual_operation(const operation& op);
+
+template <typename Operation> struct is_market_operation_type : std::false_type
+{
+};
+template <> struct is_market_operation_type<transfer_operation> : std::true_type
+{
+};
+template <> struct is_market_operation_type<transfer_to_scorumpower_operation> : std::true_type
+{
+};
+
+/**
+ * Properties of an operation type that are known without visiting the operation.
+ */
+struct operation_metadata
+{
+    const char* name = nullptr; ///< full type name, as returned by fc::get_typename
+    bool is_virtual = false;
+    bool is_market = false;
+};
+
+template <typename Variant> struct operation_table;
+
+/**
+ * Per operation type table generated from the type list of the operation variant, indexed by operation::which().
+ */
+template <typename... Operations> struct operation_table<fc::static_variant<Operations...>>
+{
+    static constexpr size_t count = sizeof...(Operations);
+
+    typedef std::bitset<count> mask_type;
+
+    static const std::array<operation_metadata, count>& metadata()
+    {
+        static const std::array<operation_metadata, count> table = { { make_metadata<Operations>()... } };
+        return table;
+    }
+
+    /// set of operation types to be used by plugins to skip operations they do not handle
+    template <typename... Subscribed> static mask_type make_mask()
+    {
+        typedef fc::static_variant<Operations...> variant_type;
+
+        mask_type mask;
+        int expand[] = { 0, (mask.set(variant_type::template tag<Subscribed>::value), 0)... };
+        (void)expand;
+        return mask;
+    }
+
+private:
+    template <typename Operation> static operation_metadata make_metadata()
+    {
+        operation_metadata result;
+        result.name = fc::get_typename<Operation>::name();
+        result.is_virtual = Operation().is_virtual();
+        result.is_market = is_market_operation_type<Operation>::value;
+        return result;
+    }
+};
+
+typedef operation_table<operation>::mask_type operation_mask;
+
+template <typename... Subscribed> operation_mask make_operation_mask()
+{
+    return operation_table<operation>::make_mask<Subscribed...>();
+}
+
+const operation_metadata& get_operation_metadata(const operation& op);
+
+/// returns tag of the operation with the full type name, or -1 if there is no such operation
+int get_operation_tag(const std::string& name);
 } // namespace protocol
 } // namespace scorum
 
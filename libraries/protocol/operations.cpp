@@ -5,42 +5,32 @@
 namespace scorum {
 namespace protocol {
 
-struct is_market_op_visitor
+bool is_market_operation(const operation& op)
 {
-    typedef bool result_type;
+    return get_operation_metadata(op).is_market;
+}
 
-    template <typename T> bool operator()(T&& v) const
-    {
-        return false;
-    }
-    bool operator()(const transfer_operation&) const
-    {
-        return true;
-    }
-    bool operator()(const transfer_to_scorumpower_operation&) const
-    {
-        return true;
-    }
-};
+bool is_virtual_operation(const operation& op)
+{
+    return get_operation_metadata(op).is_virtual;
+}
 
-bool is_market_operation(const operation& op)
+const operation_metadata& get_operation_metadata(const operation& op)
 {
-    return op.visit(is_market_op_visitor());
+    return operation_table<operation>::metadata()[op.which()];
 }
 
-struct is_vop_visitor
+int get_operation_tag(const std::string& name)
 {
-    typedef bool result_type;
+    const auto& table = operation_table<operation>::metadata();
 
-    template <typename T> bool operator()(const T& v) const
+    for (size_t i = 0; i < table.size(); ++i)
     {
-        return v.is_virtual();
+        if (name == table[i].name)
+            return (int)i;
     }
-};
 
-bool is_virtual_operation(const operation& op)
-{
-    return op.visit(is_vop_visitor());
+    return -1;
 }
 }
 } // scorum::protocol
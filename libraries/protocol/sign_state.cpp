@@ -17,7 +17,7 @@ bool sign_state::signed_by(const public_key_type& k)
     return itr->second = true;
 }
 
-bool sign_state::check_authority(const std::string& id)
+bool sign_state::check_authority(const account_name_type& id)
 {
     if (approved_by.find(id) != approved_by.end())
         return true;
@@ -82,7 +82,7 @@ sign_state::sign_state(const flat_set<public_key_type>& sigs,
 {
     for (const auto& key : sigs)
         provided_signatures[key] = false;
-    approved_by.insert("temp");
+    approved_by.insert(account_name_type("temp"));
 }
 }
 } // scorum::protocol
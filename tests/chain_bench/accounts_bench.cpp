@@ -0,0 +1,70 @@
+#ifdef IS_TEST_NET
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/services/account.hpp>
+
+#include "bench_fixture.hpp"
+
+using namespace chain_bench;
+
+namespace {
+
+struct accounts_bench_fixture : public bench_fixture
+{
+    static const uint32_t creators = 100;
+    static const uint32_t accounts_per_creator = 10;
+
+    accounts_bench_fixture()
+        : bench_fixture("accounts", creators)
+    {
+        open_bench_database();
+    }
+};
+}
+
+BOOST_AUTO_TEST_SUITE(accounts_bench)
+
+BOOST_FIXTURE_TEST_CASE(create_accounts, accounts_bench_fixture)
+{
+    try
+    {
+        const asset fee(get_account_creation_fee(), SCORUM_SYMBOL);
+
+        std::vector<Actor> created;
+        for (const Actor& creator : accounts())
+        {
+            for (uint32_t i = 0; i < accounts_per_creator; ++i)
+                created.emplace_back(creator.name + "n" + std::to_string(i));
+        }
+
+        set_parameter("created_accounts", created.size());
+
+        for (size_t i = 0; i < created.size(); ++i)
+        {
+            const Actor& creator = accounts()[i / accounts_per_creator];
+            const Actor& account = created[i];
+
+            account_create_with_delegation_operation op;
+            op.new_account_name = account.name;
+            op.creator = creator.name;
+            op.fee = fee;
+            op.delegation = asset(0, SP_SYMBOL);
+            op.owner = authority(1, account.public_key, 1);
+            op.active = authority(1, account.public_key, 1);
+            op.posting = authority(1, account.public_key, 1);
+            op.memo_key = account.public_key;
+
+            push_transaction(op, creator.private_key);
+        }
+
+        if (_pending_transactions > 0)
+            generate_bench_block();
+
+        BOOST_CHECK(db.obtain_service<dbs_account>().is_exists(created.back().name));
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
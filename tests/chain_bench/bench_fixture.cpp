@@ -0,0 +1,248 @@
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/utilities/tempdir.hpp>
+
+#include <scorum/chain/services/comment.hpp>
+
+#include <random>
+
+#include "bench_fixture.hpp"
+
+namespace chain_bench {
+
+namespace {
+// 1000 SCR for each account of the workload
+const share_value_type bench_account_scr = 1000000000000ll;
+const uint64_t bench_shared_file_size = 512ull * 1024 * 1024;
+}
+
+const uint32_t bench_fixture::transactions_per_block;
+const uint32_t bench_fixture::random_seed;
+
+bench_fixture::bench_fixture(const std::string& workload, uint32_t accounts_count)
+    : _recorder(bench_recorder::instance())
+    , _workload(workload)
+{
+    const uint32_t count = accounts_count * scale();
+
+    _accounts.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        Actor account("bench" + std::to_string(i));
+        account.scorum(asset(bench_account_scr, SCORUM_SYMBOL));
+        _accounts.push_back(account);
+    }
+
+    initdelegate.scorum(TEST_ACCOUNTS_INITIAL_SUPPLY);
+
+    Genesis genesis = Genesis::create()
+                          .accounts_supply(TEST_ACCOUNTS_INITIAL_SUPPLY
+                                           + asset(bench_account_scr * count, SCORUM_SYMBOL))
+                          .rewards_supply(TEST_REWARD_INITIAL_SUPPLY)
+                          .dev_committee(initdelegate)
+                          .accounts(initdelegate)
+                          .witnesses(initdelegate);
+
+    for (Actor account : _accounts)
+        genesis.account_create(account);
+
+    genesis_state = genesis.generate();
+
+    set_parameter("accounts", count);
+    set_parameter("transactions_per_block", transactions_per_block);
+}
+
+uint32_t bench_fixture::scale() const
+{
+    return _recorder.scale();
+}
+
+uint64_t bench_fixture::shared_file_size() const
+{
+    return bench_shared_file_size * scale();
+}
+
+const std::vector<Actor>& bench_fixture::accounts() const
+{
+    return _accounts;
+}
+
+void bench_fixture::open_bench_database()
+{
+    open_database();
+}
+
+void bench_fixture::set_parameter(const std::string& name, const fc::variant& value)
+{
+    _recorder.set_parameter(_workload, name, value);
+}
+
+void bench_fixture::push_transaction(const operation& op, const private_key_type& key, bool measured)
+{
+    signed_transaction tx;
+    tx.operations.push_back(op);
+    tx.set_expiration(db.head_block_time() + SCORUM_MAX_TIME_UNTIL_EXPIRATION);
+    tx.sign(key, db.get_chain_id());
+
+    if (measured)
+        measure("push_transaction", [&]() { db.push_transaction(tx, database::skip_nothing); });
+    else
+        db.push_transaction(tx, database::skip_nothing);
+
+    if (++_pending_transactions < transactions_per_block)
+        return;
+
+    if (measured)
+    {
+        generate_bench_block();
+    }
+    else
+    {
+        generate_block();
+        _pending_transactions = 0;
+    }
+}
+
+void bench_fixture::generate_bench_block(const std::string& metric)
+{
+    measure(metric, [&]() { generate_block(); });
+    _pending_transactions = 0;
+}
+
+void bench_fixture::vest_accounts(const asset& amount)
+{
+    for (const Actor& account : _accounts)
+    {
+        transfer_to_scorumpower_operation op;
+        op.from = account.name;
+        op.to = account.name;
+        op.amount = amount;
+
+        push_transaction(op, account.private_key, false);
+    }
+
+    generate_block();
+    _pending_transactions = 0;
+}
+
+void bench_fixture::make_transfers(uint32_t blocks)
+{
+    FC_ASSERT(_accounts.size() > 1, "Transfers need at least two accounts.");
+
+    std::mt19937 random(random_seed);
+    const uint32_t count = _accounts.size();
+
+    for (uint32_t block = 0; block < blocks; ++block)
+    {
+        for (uint32_t i = 0; i < transactions_per_block; ++i)
+        {
+            const uint32_t from = random() % count;
+            const uint32_t to = (from + 1 + random() % (count - 1)) % count;
+
+            transfer_operation op;
+            op.from = _accounts[from].name;
+            op.to = _accounts[to].name;
+            op.amount = asset(share_value_type(1000 + random() % 1000), SCORUM_SYMBOL);
+            // keeps equal transfers from being rejected as duplicates
+            op.memo = "bench " + std::to_string(++_transfers_count);
+
+            push_transaction(op, _accounts[from].private_key);
+        }
+    }
+
+    if (_pending_transactions > 0)
+        generate_bench_block();
+}
+
+void bench_fixture::post_comments()
+{
+    FC_ASSERT(_accounts.size() > 1, "Comments need at least two accounts.");
+
+    const uint32_t authors = _accounts.size() / 2;
+
+    for (uint32_t i = 0; i < authors; ++i)
+    {
+        comment_operation op;
+        op.parent_permlink = "bench";
+        op.author = _accounts[i].name;
+        op.permlink = "post";
+        op.title = "post";
+        op.body = "post of " + _accounts[i].name;
+
+        push_transaction(op, _accounts[i].private_key);
+    }
+
+    if (_pending_transactions > 0)
+        generate_bench_block();
+
+    for (uint32_t i = authors; i < _accounts.size(); ++i)
+    {
+        const Actor& parent = _accounts[(i - authors) % authors];
+
+        comment_operation op;
+        op.parent_author = parent.name;
+        op.parent_permlink = "post";
+        op.author = _accounts[i].name;
+        op.permlink = "reply";
+        op.body = "reply to " + parent.name;
+
+        push_transaction(op, _accounts[i].private_key);
+    }
+
+    if (_pending_transactions > 0)
+        generate_bench_block();
+}
+
+void bench_fixture::vote_for_comments(uint32_t rounds)
+{
+    const uint32_t authors = _accounts.size() / 2;
+
+    FC_ASSERT(rounds <= authors, "Every round should vote for a post of a different author.");
+
+    for (uint32_t round = 0; round < rounds; ++round)
+    {
+        for (uint32_t i = 0; i < _accounts.size(); ++i)
+        {
+            vote_operation op;
+            op.voter = _accounts[i].name;
+            op.author = _accounts[(i + round) % authors].name;
+            op.permlink = "post";
+            op.weight = (int16_t)100;
+
+            push_transaction(op, _accounts[i].private_key);
+        }
+
+        // an account can't vote twice in one block
+        if (_pending_transactions > 0)
+            generate_bench_block();
+    }
+}
+
+void bench_fixture::wait_for_cashout()
+{
+    const auto& comment_service = db.obtain_service<dbs_comment>();
+
+    const fc::time_point_sec first_cashout
+        = comment_service.get(_accounts.front().name, std::string("post")).cashout_time;
+    const fc::time_point_sec last_cashout
+        = comment_service.get(_accounts.back().name, std::string("reply")).cashout_time;
+
+    generate_blocks(first_cashout - SCORUM_BLOCK_INTERVAL, true);
+
+    while (db.head_block_time() < last_cashout)
+        generate_bench_block("cashout_block");
+}
+
+void bench_fixture::open_database_impl(const genesis_state_type& genesis)
+{
+    if (!data_dir)
+    {
+        data_dir = fc::temp_directory(graphene::utilities::temp_directory_path());
+        db._log_hardforks = false;
+        db.open(data_dir->path(), data_dir->path(), shared_file_size(), chainbase::database::read_write, genesis);
+        genesis_state = genesis;
+    }
+
+    database_trx_integration_fixture::open_database_impl(genesis);
+}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "database_trx_integration.hpp"
+
+#include "bench_recorder.hpp"
+
+#include <string>
+#include <vector>
+
+namespace chain_bench {
+
+using namespace database_fixture;
+
+/**
+ * Builds a reproducible chain for a workload: the genesis has the given number of funded accounts ("bench0",
+ * "bench1", ...) with keys derived from their names, block times follow the genesis time and every random choice is
+ * made by a generator with a fixed seed.
+ *
+ * Measured calls are recorded to bench_recorder under the name of the workload. Transactions of the workload are
+ * signed and pushed without skip flags, setup transactions of the fixture are not measured.
+ */
+class bench_fixture : public database_trx_integration_fixture
+{
+public:
+    static const uint32_t transactions_per_block = 100;
+    static const uint32_t random_seed = 20180701;
+
+    bench_fixture(const std::string& workload, uint32_t accounts_count);
+
+    uint32_t scale() const;
+
+    uint64_t shared_file_size() const;
+
+    const std::vector<Actor>& accounts() const;
+
+    void open_bench_database();
+
+    template <typename Call> void measure(const std::string& metric, Call&& call)
+    {
+        const fc::time_point start = fc::time_point::now();
+        call();
+        _recorder.record(_workload, metric, fc::time_point::now() - start);
+    }
+
+    void set_parameter(const std::string& name, const fc::variant& value);
+
+    /// pushes a signed transaction, a block is generated every transactions_per_block transactions
+    void push_transaction(const operation& op, const private_key_type& key, bool measured = true);
+
+    /// generates a block with all pending transactions
+    void generate_bench_block(const std::string& metric = "generate_block");
+
+    void vest_accounts(const asset& amount);
+
+    void make_transfers(uint32_t blocks);
+
+    /// first half of the accounts post, the second half replies to them
+    void post_comments();
+
+    /// every account votes for a comment of a different author each round
+    void vote_for_comments(uint32_t rounds);
+
+    /// generates the blocks that pay the comments, they are recorded as "cashout_block"
+    void wait_for_cashout();
+
+protected:
+    virtual void open_database_impl(const genesis_state_type& genesis) override;
+
+    bench_recorder& _recorder;
+    const std::string _workload;
+
+    std::vector<Actor> _accounts;
+    uint32_t _pending_transactions = 0;
+    uint32_t _transfers_count = 0;
+};
+}
@@ -0,0 +1,104 @@
+#include <boost/test/unit_test.hpp>
+
+#include <fc/io/json.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+#include "bench_recorder.hpp"
+
+namespace chain_bench {
+
+bench_recorder& bench_recorder::instance()
+{
+    static bench_recorder recorder;
+    return recorder;
+}
+
+bench_recorder::bench_recorder()
+{
+    static const std::string output_arg = "--bench-output=";
+    static const std::string scale_arg = "--bench-scale=";
+
+    int argc = boost::unit_test::framework::master_test_suite().argc;
+    char** argv = boost::unit_test::framework::master_test_suite().argv;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg.compare(0, output_arg.size(), output_arg) == 0)
+            _output = arg.substr(output_arg.size());
+        else if (arg.compare(0, scale_arg.size(), scale_arg) == 0)
+            _scale = std::max<uint32_t>(1u, std::stoul(arg.substr(scale_arg.size())));
+    }
+}
+
+void bench_recorder::record(const std::string& workload, const std::string& metric, const fc::microseconds& elapsed)
+{
+    _samples[workload][metric].push_back(elapsed.count());
+}
+
+void bench_recorder::set_parameter(const std::string& workload, const std::string& name, const fc::variant& value)
+{
+    _parameters[workload](name, value);
+}
+
+uint32_t bench_recorder::scale() const
+{
+    return _scale;
+}
+
+fc::variant bench_recorder::summarize(const samples_type& samples)
+{
+    samples_type sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+
+    const int64_t total = std::accumulate(sorted.begin(), sorted.end(), int64_t(0));
+    const int64_t count = sorted.size();
+
+    auto percentile = [&](int64_t p) { return sorted[(count - 1) * p / 100]; };
+
+    fc::mutable_variant_object result;
+    result("count", count);
+    result("total_ms", double(total) / 1000);
+    result("per_second", total > 0 ? double(count) * 1000000 / total : 0.);
+    result("mean_us", total / count);
+    result("p50_us", percentile(50));
+    result("p90_us", percentile(90));
+    result("p99_us", percentile(99));
+    result("max_us", sorted.back());
+
+    return fc::variant(result);
+}
+
+fc::variant bench_recorder::report() const
+{
+    fc::mutable_variant_object workloads;
+
+    for (const auto& workload : _samples)
+    {
+        fc::mutable_variant_object metrics;
+        for (const auto& metric : workload.second)
+            metrics(metric.first, summarize(metric.second));
+
+        fc::mutable_variant_object parameters;
+        auto it = _parameters.find(workload.first);
+        if (it != _parameters.end())
+            parameters = it->second;
+
+        workloads(workload.first, fc::mutable_variant_object("parameters", parameters)("metrics", metrics));
+    }
+
+    return fc::variant(fc::mutable_variant_object("scale", _scale)("workloads", workloads));
+}
+
+void bench_recorder::save() const
+{
+    const fc::variant result = report();
+
+    if (_output.empty())
+        std::cout << fc::json::to_pretty_string(result) << std::endl;
+    else
+        fc::json::save_to_file(result, fc::path(_output));
+}
+}
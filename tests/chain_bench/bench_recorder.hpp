@@ -0,0 +1,59 @@
+#pragma once
+
+#include <fc/time.hpp>
+#include <fc/variant.hpp>
+#include <fc/variant_object.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace chain_bench {
+
+/**
+ * Collects the latency of every measured call of the workloads and writes a JSON report when all workloads have been
+ * run:
+ *
+ *  {
+ *    "scale": 1,
+ *    "workloads": {
+ *      "transfers": {
+ *        "parameters": { "accounts": 200, ... },
+ *        "metrics": {
+ *          "push_transaction": { "count": 10000, "total_ms": .., "per_second": .., "mean_us": .., "p50_us": ..,
+ *                                "p90_us": .., "p99_us": .., "max_us": .. },
+ *          ...
+ *
+ * Arguments are given after "--" on the command line:
+ *  --bench-output=<file>  write the report to the file instead of stdout
+ *  --bench-scale=<n>      multiply the sizes of all workloads by n
+ */
+class bench_recorder
+{
+public:
+    static bench_recorder& instance();
+
+    void record(const std::string& workload, const std::string& metric, const fc::microseconds& elapsed);
+
+    void set_parameter(const std::string& workload, const std::string& name, const fc::variant& value);
+
+    uint32_t scale() const;
+
+    fc::variant report() const;
+
+    void save() const;
+
+private:
+    bench_recorder();
+
+    using samples_type = std::vector<int64_t>;
+
+    static fc::variant summarize(const samples_type& samples);
+
+    std::map<std::string, std::map<std::string, samples_type>> _samples;
+    std::map<std::string, fc::mutable_variant_object> _parameters;
+
+    uint32_t _scale = 1;
+    std::string _output;
+};
+}
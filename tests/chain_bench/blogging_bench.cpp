@@ -0,0 +1,44 @@
+#ifdef IS_TEST_NET
+#include <boost/test/unit_test.hpp>
+
+#include "bench_fixture.hpp"
+
+using namespace chain_bench;
+
+namespace {
+
+struct blogging_bench_fixture : public bench_fixture
+{
+    static const uint32_t vote_rounds = 10;
+
+    blogging_bench_fixture()
+        : bench_fixture("blogging", 200)
+    {
+        open_bench_database();
+
+        // voters need scorumpower to have weight
+        vest_accounts(ASSET_SCR(500e+9));
+    }
+};
+}
+
+BOOST_AUTO_TEST_SUITE(blogging_bench)
+
+BOOST_FIXTURE_TEST_CASE(post_vote_and_cashout, blogging_bench_fixture)
+{
+    try
+    {
+        set_parameter("vote_rounds", vote_rounds);
+
+        post_comments();
+        vote_for_comments(vote_rounds);
+        wait_for_cashout();
+
+        validate_database();
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,50 @@
+#ifdef IS_TEST_NET
+
+#include <cstdlib>
+#include <iostream>
+#include <boost/test/included/unit_test.hpp>
+
+#include <fc/log/logger.hpp>
+#include <fc/log/logger_config.hpp>
+#include <fc/reflect/variant.hpp>
+
+#include "bench_recorder.hpp"
+
+boost::unit_test::test_suite* init_unit_test_suite(int argc, char* argv[])
+{
+    fc::logging_config log_conf;
+
+    fc::variants c;
+    c.push_back(fc::mutable_variant_object("level", "debug")("color", "green"));
+    c.push_back(fc::mutable_variant_object("level", "warn")("color", "brown"));
+    c.push_back(fc::mutable_variant_object("level", "error")("color", "red"));
+
+    log_conf.appenders.push_back(fc::appender_config(
+        "stderr", "console", fc::mutable_variant_object()("stream", "std_error")("level_colors", c)));
+
+    fc::logger_config lg;
+    lg.name = "default";
+    lg.level = fc::log_level::error;
+    lg.appenders.push_back("stderr");
+    log_conf.loggers.push_back(lg);
+    fc::configure_logging(log_conf);
+    return nullptr;
+}
+
+// writes the results of all workloads that have been run
+struct bench_report_fixture
+{
+    ~bench_report_fixture()
+    {
+        chain_bench::bench_recorder::instance().save();
+    }
+};
+
+BOOST_GLOBAL_FIXTURE(bench_report_fixture);
+
+#else
+int main(int argc, char** argv)
+{
+    return 0;
+}
+#endif
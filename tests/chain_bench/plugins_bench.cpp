@@ -0,0 +1,63 @@
+#ifdef IS_TEST_NET
+#include <boost/test/unit_test.hpp>
+#include <boost/program_options.hpp>
+
+#include <scorum/account_by_key/account_by_key_plugin.hpp>
+#include <scorum/account_statistics/account_statistics_plugin.hpp>
+#include <scorum/blockchain_history/blockchain_history_plugin.hpp>
+#include <scorum/blockchain_statistics/blockchain_statistics_plugin.hpp>
+#include <scorum/tags/tags_plugin.hpp>
+
+#include "bench_fixture.hpp"
+
+using namespace chain_bench;
+
+namespace {
+
+// the transfers and blogging mix applied with the plugins of an API node
+struct plugins_bench_fixture : public bench_fixture
+{
+    static const uint32_t transfer_blocks = 20;
+    static const uint32_t vote_rounds = 5;
+
+    plugins_bench_fixture()
+        : bench_fixture("plugins", 200)
+    {
+        boost::program_options::variables_map options;
+
+        app.register_plugin<scorum::account_by_key::account_by_key_plugin>()->plugin_initialize(options);
+        app.register_plugin<scorum::tags::tags_plugin>()->plugin_initialize(options);
+        app.register_plugin<scorum::blockchain_history::blockchain_history_plugin>()->plugin_initialize(options);
+        app.register_plugin<scorum::blockchain_statistics::blockchain_statistics_plugin>()->plugin_initialize(options);
+        app.register_plugin<scorum::account_statistics::account_statistics_plugin>()->plugin_initialize(options);
+
+        open_bench_database();
+
+        vest_accounts(ASSET_SCR(500e+9));
+    }
+};
+}
+
+BOOST_AUTO_TEST_SUITE(plugins_bench)
+
+BOOST_FIXTURE_TEST_CASE(transfers_and_blogging_with_plugins, plugins_bench_fixture)
+{
+    try
+    {
+        set_parameter("transfer_blocks", transfer_blocks * scale());
+        set_parameter("vote_rounds", vote_rounds);
+
+        make_transfers(transfer_blocks * scale());
+
+        post_comments();
+        vote_for_comments(vote_rounds);
+        wait_for_cashout();
+
+        validate_database();
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,87 @@
+#ifdef IS_TEST_NET
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/utilities/tempdir.hpp>
+
+#include "bench_fixture.hpp"
+
+using namespace chain_bench;
+
+namespace {
+
+struct replay_bench_fixture : public bench_fixture
+{
+    static const uint32_t transfer_blocks = 50;
+    static const uint32_t vote_rounds = 5;
+
+    replay_bench_fixture()
+        : bench_fixture("replay", 200)
+    {
+        open_bench_database();
+
+        vest_accounts(ASSET_SCR(500e+9));
+    }
+};
+}
+
+BOOST_AUTO_TEST_SUITE(replay_bench)
+
+BOOST_FIXTURE_TEST_CASE(push_blocks_and_reindex, replay_bench_fixture)
+{
+    try
+    {
+        make_transfers(transfer_blocks * scale());
+        post_comments();
+        vote_for_comments(vote_rounds);
+
+        const uint32_t blocks = db.head_block_num();
+
+        set_parameter("blocks", blocks);
+
+        // applies the blocks as a node syncing from the network
+        fc::temp_directory replay_dir(graphene::utilities::temp_directory_path());
+        {
+            database replay_db;
+            replay_db._log_hardforks = false;
+            replay_db.open(replay_dir.path(), replay_dir.path(), shared_file_size(), chainbase::database::read_write,
+                           genesis_state);
+
+            for (uint32_t num = 1; num <= blocks; ++num)
+            {
+                const auto block = db.fetch_block_by_number(num);
+                BOOST_REQUIRE(block.valid());
+
+                // transactions of the fixture setup are not signed
+                measure("push_block", [&]() { replay_db.push_block(*block, database::skip_authority_check); });
+            }
+
+            BOOST_REQUIRE(replay_db.head_block_id() == db.head_block_id());
+
+            replay_db.close();
+        }
+
+        // rebuilds the state from the block log of the synced node
+        fc::temp_directory reindex_dir(graphene::utilities::temp_directory_path());
+        {
+            database reindex_db;
+            reindex_db._log_hardforks = false;
+
+            const fc::time_point start = fc::time_point::now();
+            measure("reindex", [&]() {
+                reindex_db.reindex(replay_dir.path(), reindex_dir.path(), shared_file_size(), genesis_state);
+            });
+            const double seconds = double((fc::time_point::now() - start).count()) / 1000000;
+
+            set_parameter("reindex_blocks_per_second", seconds > 0 ? blocks / seconds : 0.);
+
+            BOOST_REQUIRE_EQUAL(reindex_db.head_block_num(), blocks);
+
+            reindex_db.close();
+        }
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,39 @@
+#ifdef IS_TEST_NET
+#include <boost/test/unit_test.hpp>
+
+#include "bench_fixture.hpp"
+
+using namespace chain_bench;
+
+namespace {
+
+struct transfers_bench_fixture : public bench_fixture
+{
+    transfers_bench_fixture()
+        : bench_fixture("transfers", 200)
+    {
+        open_bench_database();
+    }
+};
+}
+
+BOOST_AUTO_TEST_SUITE(transfers_bench)
+
+BOOST_FIXTURE_TEST_CASE(random_transfers, transfers_bench_fixture)
+{
+    try
+    {
+        const uint32_t blocks = 100 * scale();
+
+        set_parameter("blocks", blocks);
+
+        make_transfers(blocks);
+
+        validate_database();
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
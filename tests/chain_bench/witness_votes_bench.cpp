@@ -0,0 +1,95 @@
+#ifdef IS_TEST_NET
+#include <boost/test/unit_test.hpp>
+
+#include "bench_fixture.hpp"
+
+using namespace chain_bench;
+
+namespace {
+
+struct witness_votes_bench_fixture : public bench_fixture
+{
+    // the head of a chain votes, the others proxy their votes to the previous account
+    static const uint32_t proxy_chain_length = SCORUM_MAX_PROXY_RECURSION_DEPTH + 1;
+    static const uint32_t vesting_rounds = 10;
+
+    witness_votes_bench_fixture()
+        : bench_fixture("witness_votes", 200)
+    {
+        open_bench_database();
+
+        vest_accounts(ASSET_SCR(100e+9));
+
+        witnesses.push_back(initdelegate.name);
+        for (int i = TEST_NUM_INIT_DELEGATES; i < SCORUM_MAX_WITNESSES; i++)
+            witnesses.push_back(initdelegate.name + fc::to_string(i));
+    }
+
+    std::vector<std::string> witnesses;
+};
+}
+
+BOOST_AUTO_TEST_SUITE(witness_votes_bench)
+
+BOOST_FIXTURE_TEST_CASE(vote_through_proxy_chains, witness_votes_bench_fixture)
+{
+    try
+    {
+        set_parameter("proxy_chain_length", proxy_chain_length);
+        set_parameter("witnesses", witnesses.size());
+        set_parameter("vesting_rounds", vesting_rounds);
+
+        for (size_t i = 0; i < accounts().size(); ++i)
+        {
+            const Actor& account = accounts()[i];
+
+            if (i % proxy_chain_length == 0)
+            {
+                for (const std::string& witness : witnesses)
+                {
+                    account_witness_vote_operation op;
+                    op.account = account.name;
+                    op.witness = witness;
+                    op.approve = true;
+
+                    push_transaction(op, account.private_key);
+                }
+            }
+            else
+            {
+                account_witness_proxy_operation op;
+                op.account = account.name;
+                op.proxy = accounts()[i - 1].name;
+
+                push_transaction(op, account.private_key);
+            }
+        }
+
+        if (_pending_transactions > 0)
+            generate_bench_block();
+
+        // every scorumpower change is propagated along the proxy chain to the witnesses
+        for (uint32_t round = 0; round < vesting_rounds; ++round)
+        {
+            for (const Actor& account : accounts())
+            {
+                transfer_to_scorumpower_operation op;
+                op.from = account.name;
+                op.to = account.name;
+                op.amount = ASSET_SCR(1e+9 + round);
+
+                push_transaction(op, account.private_key);
+            }
+
+            if (_pending_transactions > 0)
+                generate_bench_block();
+        }
+
+        validate_database();
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -108,6 +108,27 @@ BOOST_AUTO_TEST_CASE(check_fee_after_creation)
     FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_CASE(cached_authority_follows_authority_changes)
+{
+    try
+    {
+        create_account();
+
+        BOOST_CHECK(data_service.get_authority(user.name, authority::owner) == authority());
+
+        const authority new_owner(1, user.public_key, 1);
+        data_service.update_owner_authority(data_service.get_account(user.name), new_owner);
+
+        BOOST_CHECK(data_service.get_authority(user.name, authority::owner) == new_owner);
+
+        generate_block();
+
+        BOOST_CHECK(data_service.get_authority(user.name, authority::owner) == new_owner);
+        BOOST_CHECK(data_service.get_authority(user.name, authority::active) == authority());
+    }
+    FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // database_fixture
@@ -3,6 +3,7 @@
 
 #include <scorum/chain/services/atomicswap.hpp>
 #include <scorum/chain/services/account.hpp>
+#include <scorum/chain/services/dynamic_global_property.hpp>
 
 #include <scorum/chain/schema/account_objects.hpp>
 #include <scorum/chain/schema/atomicswap_objects.hpp>
@@ -252,6 +253,25 @@ SCORUM_TEST_CASE(refund)
     BOOST_REQUIRE_EQUAL(bob.balance, BOB_BALANCE);
 }
 
+SCORUM_TEST_CASE(expired_contract_is_refunded)
+{
+    dbs_dynamic_global_property& dgp_service = db.obtain_service<dbs_dynamic_global_property>();
+
+    const time_point_sec deadline = atomicswap_service.get_contract(bob, alice, alice_secret_hash).deadline;
+
+    dgp_service.update([&](dynamic_global_property_object& p) { p.time = deadline - 1; });
+    atomicswap_service.check_contracts_expiration();
+
+    BOOST_REQUIRE_NO_THROW(atomicswap_service.get_contract(bob, alice, alice_secret_hash));
+    BOOST_REQUIRE_EQUAL(bob.balance, BOB_BALANCE - BOB_SHARE_FOR_ALICE);
+
+    dgp_service.update([&](dynamic_global_property_object& p) { p.time = deadline; });
+    atomicswap_service.check_contracts_expiration();
+
+    BOOST_REQUIRE_THROW(atomicswap_service.get_contract(bob, alice, alice_secret_hash), fc::exception);
+    BOOST_REQUIRE_EQUAL(bob.balance, BOB_BALANCE);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif
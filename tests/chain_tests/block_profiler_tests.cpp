@@ -0,0 +1,207 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/database/block_profiler.hpp>
+
+#include "database_trx_integration.hpp"
+
+#include <boost/signals2/connection.hpp>
+
+#include <algorithm>
+
+using namespace scorum;
+using namespace scorum::chain;
+using namespace scorum::protocol;
+
+namespace block_profiler_tests {
+
+struct block_profiler_fixture : public database_fixture::database_trx_integration_fixture
+{
+    block_profiler_fixture()
+        : alice("alice")
+    {
+        open_database();
+        generate_block();
+
+        actor(initdelegate).create_account(alice);
+        generate_block();
+    }
+
+    const block_phase_stats* find_phase(const block_profile& profile, const std::string& phase)
+    {
+        for (const block_phase_stats& stats : profile.phases)
+        {
+            if (stats.phase == phase)
+                return &stats;
+        }
+        return nullptr;
+    }
+
+    const plugin_handler_stats* find_handler(const block_profile& profile, const std::string& plugin)
+    {
+        for (const plugin_handler_stats& stats : profile.handlers)
+        {
+            if (stats.plugin == plugin)
+                return &stats;
+        }
+        return nullptr;
+    }
+
+    Actor alice;
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(block_profiler_tests, block_profiler_tests::block_profiler_fixture)
+
+SCORUM_TEST_CASE(phase_names_test)
+{
+    BOOST_CHECK_EQUAL(block_profiler::phase_name(block_profiler::block), "block");
+    BOOST_CHECK_EQUAL(block_profiler::phase_name(block_profiler::applied_block_signal), "applied_block_signal");
+
+    transfer_operation op;
+    BOOST_CHECK_EQUAL(block_profiler::phase_name(block_profiler::evaluator_phase(operation(op))), "evaluator:transfer");
+}
+
+SCORUM_TEST_CASE(last_block_profile_has_applied_operations_test)
+{
+    actor(initdelegate).give_scr(alice, 100);
+    generate_block();
+
+    const block_profile profile = db.get_block_profiler().get_last_block_profile();
+
+    BOOST_CHECK_EQUAL(profile.last_block, db.head_block_num());
+
+    const block_phase_stats* block = find_phase(profile, "block");
+    BOOST_REQUIRE(block != nullptr);
+    BOOST_CHECK_EQUAL(block->count, 1u);
+
+    const block_phase_stats* transaction = find_phase(profile, "transaction");
+    BOOST_REQUIRE(transaction != nullptr);
+    BOOST_CHECK_EQUAL(transaction->count, 1u);
+
+    const block_phase_stats* evaluator = find_phase(profile, "evaluator:transfer");
+    BOOST_REQUIRE(evaluator != nullptr);
+    BOOST_CHECK_EQUAL(evaluator->count, 1u);
+
+    BOOST_CHECK(find_phase(profile, "evaluator:account_create") == nullptr);
+}
+
+SCORUM_TEST_CASE(profile_rolls_window_test)
+{
+    block_profiler& profiler = db.get_block_profiler();
+    profiler.reset();
+    profiler.set_window(2);
+
+    generate_blocks(5);
+
+    const block_profile profile = profiler.get_profile();
+
+    // the current generation has one block, the previous one has two
+    const block_phase_stats* block = find_phase(profile, "block");
+    BOOST_REQUIRE(block != nullptr);
+    BOOST_CHECK_EQUAL(block->count, 3u);
+    BOOST_CHECK_EQUAL(block->histogram.size(), block_profiler::histogram_buckets);
+    BOOST_CHECK_EQUAL(profile.first_block, db.head_block_num() - 2);
+    BOOST_CHECK_EQUAL(profile.last_block, db.head_block_num());
+}
+
+SCORUM_TEST_CASE(pending_transactions_are_not_profiled_test)
+{
+    block_profiler& profiler = db.get_block_profiler();
+    profiler.reset();
+
+    actor(initdelegate).give_scr(alice, 100);
+
+    BOOST_CHECK(find_phase(profiler.get_profile(), "evaluator:transfer") == nullptr);
+}
+
+SCORUM_TEST_CASE(plugin_handlers_are_profiled_per_plugin_test)
+{
+    uint32_t calls = 0;
+    boost::signals2::scoped_connection connection = db.connect_plugin_handler(
+        "test_plugin", db.post_apply_operation, [&](const operation_notification&) { ++calls; });
+
+    actor(initdelegate).give_scr(alice, 100);
+    generate_block();
+
+    const block_profile profile = db.get_block_profiler().get_profile();
+
+    const plugin_handler_stats* handler = find_handler(profile, "test_plugin");
+    BOOST_REQUIRE(handler != nullptr);
+    BOOST_CHECK_EQUAL(handler->signal, "post_apply_operation_signal");
+    BOOST_CHECK(!handler->async);
+    // pending transactions call the handler too, only the applied block is profiled
+    BOOST_CHECK_LT(handler->count, calls);
+    BOOST_CHECK_GT(handler->count, 0u);
+}
+
+SCORUM_TEST_CASE(async_plugin_handlers_get_copies_of_notifications_test)
+{
+    std::vector<operation> operations;
+    std::vector<uint32_t> blocks;
+
+    boost::signals2::scoped_connection operations_connection = db.connect_plugin_handler(
+        "async_plugin", db.post_apply_operation,
+        [&](const operation_notification& note) { operations.push_back(note.op); }, true);
+    boost::signals2::scoped_connection blocks_connection = db.connect_plugin_handler(
+        "async_plugin", db.applied_block, [&](const signed_block& block) { blocks.push_back(block.block_num()); },
+        true);
+
+    actor(initdelegate).give_scr(alice, 100);
+    generate_block();
+
+    db.flush_async_notifications();
+
+    BOOST_REQUIRE_EQUAL(blocks.size(), 1u);
+    BOOST_CHECK_EQUAL(blocks.front(), db.head_block_num());
+
+    const bool has_transfer
+        = std::any_of(operations.begin(), operations.end(),
+                      [](const operation& op) { return op.which() == operation::tag<transfer_operation>::value; });
+    BOOST_CHECK(has_transfer);
+
+    const block_profile profile = db.get_block_profiler().get_profile();
+
+    const plugin_handler_stats* handler = find_handler(profile, "async_plugin");
+    BOOST_REQUIRE(handler != nullptr);
+    BOOST_CHECK(handler->async);
+}
+
+SCORUM_TEST_CASE(async_plugin_handlers_are_not_notified_of_pending_transactions_test)
+{
+    uint32_t transactions = 0;
+    std::vector<operation> operations;
+
+    boost::signals2::scoped_connection transactions_connection = db.connect_plugin_handler(
+        "async_plugin", db.on_pre_apply_transaction, [&](const signed_transaction&) { ++transactions; }, true);
+    boost::signals2::scoped_connection operations_connection = db.connect_plugin_handler(
+        "async_plugin", db.post_apply_operation,
+        [&](const operation_notification& note) { operations.push_back(note.op); }, true);
+
+    actor(initdelegate).give_scr(alice, 100);
+
+    db.flush_async_notifications();
+
+    BOOST_CHECK_EQUAL(transactions, 0u);
+    BOOST_CHECK(operations.empty());
+
+    generate_block();
+
+    db.flush_async_notifications();
+
+    // the transaction is applied as pending, again when the block is generated and then in the block
+    BOOST_CHECK_EQUAL(transactions, 1u);
+    BOOST_CHECK_EQUAL(std::count_if(operations.begin(), operations.end(),
+                                    [](const operation& op) {
+                                        return op.which() == operation::tag<transfer_operation>::value;
+                                    }),
+                      1);
+}
+
+SCORUM_TEST_CASE(only_plugin_signals_can_be_profiled_test)
+{
+    BOOST_CHECK_THROW(
+        db.connect_plugin_handler("test_plugin", db.on_applied_transaction, [](const signed_transaction&) {}),
+        fc::assert_exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -531,6 +531,40 @@ BOOST_FIXTURE_TEST_CASE(optional_tapos, database_default_integration_fixture)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(recent_transaction_lookup, database_default_integration_fixture)
+{
+    try
+    {
+        ACTORS((alice)(bob));
+
+        generate_block();
+
+        transfer(TEST_INIT_DELEGATE_NAME, "alice", asset(1000000, SCORUM_SYMBOL));
+        transfer_operation op;
+        op.from = "alice";
+        op.to = "bob";
+        op.amount = asset(1000, SCORUM_SYMBOL);
+        signed_transaction tx;
+        tx.operations.push_back(op);
+        tx.set_expiration(db.head_block_time() + SCORUM_MAX_TIME_UNTIL_EXPIRATION);
+        tx.sign(alice_private_key, db.get_chain_id());
+        PUSH_TX(db, tx);
+
+        BOOST_TEST_MESSAGE("pending transaction");
+
+        BOOST_REQUIRE(db.is_known_transaction(tx.id()));
+        BOOST_CHECK(db.get_recent_transaction(tx.id()).id() == tx.id());
+
+        BOOST_TEST_MESSAGE("transaction included in block");
+
+        generate_block();
+
+        BOOST_REQUIRE(db.is_known_transaction(tx.id()));
+        BOOST_CHECK(db.get_recent_transaction(tx.id()).id() == tx.id());
+    }
+    FC_LOG_AND_RETHROW()
+}
+
 BOOST_FIXTURE_TEST_CASE(double_sign_check, database_default_integration_fixture)
 {
     try
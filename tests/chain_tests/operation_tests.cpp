@@ -1425,6 +1425,49 @@ BOOST_AUTO_TEST_CASE(account_witness_vote_apply)
     FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_CASE(batched_witness_votes_match_sequential)
+{
+    try
+    {
+        BOOST_TEST_MESSAGE("Testing: batched_witness_votes_match_sequential");
+
+        ACTORS((alice)(bob))
+        fund("alice", 5000);
+        vest("alice", 5000);
+        fund("bob", 1000);
+
+        witness_create("alice", alice_private_key, "foo.bar", alice_private_key.get_public_key(), 1000);
+        witness_create("bob", bob_private_key, "foo.bar", bob_private_key.get_public_key(), 1000);
+
+        auto& witness_service = db.obtain_service<dbs_witness>();
+        const witness_object& alice_witness = witness_service.get("alice");
+        const witness_object& bob_witness = witness_service.get("bob");
+
+        witness_service.adjust_witness_vote(alice_witness, 1000);
+        witness_service.adjust_witness_vote(alice_witness, -300);
+        witness_service.adjust_witness_vote(alice_witness, 50);
+
+        witness_service.begin_votes_batch();
+        witness_service.adjust_witness_vote(bob_witness, 1000);
+        witness_service.adjust_witness_vote(bob_witness, -300);
+        witness_service.adjust_witness_vote(bob_witness, 50);
+
+        BOOST_REQUIRE(bob_witness.votes.value == 0);
+
+        witness_service.flush_votes_batch();
+        witness_service.end_votes_batch();
+
+        BOOST_REQUIRE(bob_witness.votes.value == 750);
+        BOOST_REQUIRE(bob_witness.votes == alice_witness.votes);
+        BOOST_REQUIRE(bob_witness.virtual_last_update == alice_witness.virtual_last_update);
+        BOOST_REQUIRE(bob_witness.virtual_position == alice_witness.virtual_position);
+        BOOST_REQUIRE(bob_witness.virtual_scheduled_time == alice_witness.virtual_scheduled_time);
+
+        validate_database();
+    }
+    FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_CASE(account_witness_proxy_validate)
 {
     try
@@ -3361,12 +3404,10 @@ BOOST_AUTO_TEST_CASE(account_bandwidth)
 
         db.push_transaction(tx, 0);
 
-        auto last_bandwidth_update = db.get<witness::account_bandwidth_object, witness::by_account_bandwidth_type>(
-                                           boost::make_tuple("alice", witness::bandwidth_type::market))
-                                         .last_bandwidth_update;
-        auto average_bandwidth = db.get<witness::account_bandwidth_object, witness::by_account_bandwidth_type>(
-                                       boost::make_tuple("alice", witness::bandwidth_type::market))
-                                     .average_bandwidth;
+        auto last_bandwidth_update
+            = wit_plugin->get_account_bandwidth("alice", witness::bandwidth_type::market).last_bandwidth_update;
+        auto average_bandwidth
+            = wit_plugin->get_account_bandwidth("alice", witness::bandwidth_type::market).average_bandwidth;
         BOOST_REQUIRE(last_bandwidth_update == db.head_block_time());
         BOOST_REQUIRE(average_bandwidth == fc::raw::pack_size(tx) * 10 * SCORUM_BANDWIDTH_PRECISION);
         auto total_bandwidth = average_bandwidth;
@@ -3381,14 +3422,95 @@ BOOST_AUTO_TEST_CASE(account_bandwidth)
 
         db.push_transaction(tx, 0);
 
-        last_bandwidth_update = db.get<witness::account_bandwidth_object, witness::by_account_bandwidth_type>(
-                                      boost::make_tuple("alice", witness::bandwidth_type::market))
-                                    .last_bandwidth_update;
-        average_bandwidth = db.get<witness::account_bandwidth_object, witness::by_account_bandwidth_type>(
-                                  boost::make_tuple("alice", witness::bandwidth_type::market))
-                                .average_bandwidth;
+        last_bandwidth_update
+            = wit_plugin->get_account_bandwidth("alice", witness::bandwidth_type::market).last_bandwidth_update;
+        average_bandwidth = wit_plugin->get_account_bandwidth("alice", witness::bandwidth_type::market).average_bandwidth;
         BOOST_REQUIRE(last_bandwidth_update == db.head_block_time());
         BOOST_REQUIRE(average_bandwidth == total_bandwidth + fc::raw::pack_size(tx) * 10 * SCORUM_BANDWIDTH_PRECISION);
+        total_bandwidth = average_bandwidth;
+
+        BOOST_TEST_MESSAGE("--- Test bandwidth is written to the database when the block is irreversible");
+
+        generate_block();
+
+        const auto trx_block_num = db.head_block_num();
+        while (db.get_last_irreversible_block_num() < trx_block_num)
+            generate_block();
+
+        const auto& band = db.get<witness::account_bandwidth_object, witness::by_account_bandwidth_type>(
+            boost::make_tuple("alice", witness::bandwidth_type::market));
+        BOOST_REQUIRE_EQUAL(band.average_bandwidth,
+                            wit_plugin->get_account_bandwidth("alice", witness::bandwidth_type::market).average_bandwidth);
+        BOOST_REQUIRE(band.lifetime_bandwidth >= total_bandwidth);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+BOOST_AUTO_TEST_CASE(account_bandwidth_near_limit_is_charged_once)
+{
+    try
+    {
+        BOOST_TEST_MESSAGE("Testing: account_bandwidth_near_limit_is_charged_once");
+        ACTORS((alice)(bob))
+        fund("alice", ASSET_SCR(10e+3));
+        generate_block();
+
+        signed_transaction tx;
+        transfer_operation op;
+
+        op.from = "alice";
+        op.to = "bob";
+        op.amount = ASSET_SCR(1e+3);
+
+        tx.operations.push_back(op);
+        tx.set_expiration(db.head_block_time() + SCORUM_MAX_TIME_UNTIL_EXPIRATION);
+        tx.sign(alice_private_key, db.get_chain_id());
+
+        const share_type trx_bandwidth = fc::raw::pack_size(tx) * 10 * SCORUM_BANDWIDTH_PRECISION;
+        auto alice_bandwidth = [&]() {
+            return wit_plugin->get_account_bandwidth("alice", witness::bandwidth_type::market).average_bandwidth;
+        };
+
+        BOOST_TEST_MESSAGE("--- Leave alice bandwidth for one and a half of the transaction");
+
+        // alice may have average bandwidth up to alice_vshares * max_virtual_bandwidth / total_vshares
+        const fc::uint128 max_virtual_bandwidth = db.get(witness::reserve_ratio_id_type()).max_virtual_bandwidth;
+        const fc::uint128 total_vshares(
+            db.obtain_service<dbs_dynamic_global_property>().get().total_scorumpower.amount.value);
+        const fc::uint128 alice_vshares(alice.effective_scorumpower().amount.value);
+        const fc::uint128 allowed_bandwidth = fc::uint128(trx_bandwidth.value) * 3 / 2;
+
+        if (alice_vshares * max_virtual_bandwidth < allowed_bandwidth * total_vshares)
+            vest("alice",
+                 share_type(
+                     ((allowed_bandwidth * total_vshares) / max_virtual_bandwidth - alice_vshares).to_uint64()));
+        else
+            vest("bob",
+                 share_type(((alice_vshares * max_virtual_bandwidth) / allowed_bandwidth - total_vshares).to_uint64()));
+
+        generate_block();
+
+        BOOST_TEST_MESSAGE("--- Test transaction applied again after the pending state is cleared");
+
+        db.push_transaction(tx, 0);
+        db.clear_pending();
+
+        BOOST_REQUIRE_EQUAL(alice_bandwidth(), share_type(0));
+
+        db.push_transaction(tx, 0);
+
+        BOOST_REQUIRE_EQUAL(alice_bandwidth(), trx_bandwidth);
+
+        BOOST_TEST_MESSAGE("--- Test transaction is included in the generated block and charged once");
+
+        generate_block();
+
+        const auto block = db.fetch_block_by_number(db.head_block_num());
+        BOOST_REQUIRE(block.valid());
+        BOOST_REQUIRE_EQUAL(block->transactions.size(), 1u);
+        BOOST_REQUIRE(block->transactions.front().id() == tx.id());
+
+        BOOST_REQUIRE_EQUAL(alice_bandwidth(), trx_bandwidth);
     }
     FC_LOG_AND_RETHROW()
 }
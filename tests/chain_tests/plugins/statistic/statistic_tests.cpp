@@ -1,10 +1,13 @@
 #include <boost/test/unit_test.hpp>
 
+#include <scorum/blockchain_statistics/blockchain_statistics_api.hpp>
 #include <scorum/blockchain_statistics/blockchain_statistics_plugin.hpp>
 #include <scorum/common_statistics/base_plugin_impl.hpp>
 #include <scorum/chain/services/account.hpp>
 #include <scorum/chain/schema/account_objects.hpp>
 
+#include <scorum/app/api_context.hpp>
+
 #include "database_trx_integration.hpp"
 
 using namespace scorum;
@@ -60,6 +63,13 @@ struct stat_database_fixture : public database_trx_integration_fixture
         return *itr;
     }
 
+    const timeline_object& get_last_checkpoint() const
+    {
+        const auto& timeline_idx = db.get_index<timeline_index>().indices().get<by_open>();
+        FC_ASSERT(!timeline_idx.empty());
+        return *timeline_idx.rbegin();
+    }
+
     void start_withdraw(share_type to_withdraw)
     {
         withdraw_scorumpower_operation op;
@@ -203,6 +213,59 @@ SCORUM_TEST_CASE(transfers_stat_test)
     BOOST_REQUIRE_EQUAL(bucket.scorum_transferred, orig_val_scr + 1);
 }
 
+SCORUM_TEST_CASE(pending_operations_are_counted_once_per_block_test)
+{
+    const bucket_object& bucket = get_lifetime_bucket();
+
+    auto orig_val = bucket.transfers;
+
+    transfer_operation op;
+    op.from = TEST_INIT_DELEGATE_NAME;
+    op.to = alice;
+    op.amount = asset(1, SCORUM_SYMBOL);
+
+    push_operation(op, fc::ecc::private_key(), false);
+
+    BOOST_REQUIRE_EQUAL(bucket.transfers, orig_val);
+
+    generate_block();
+
+    BOOST_REQUIRE_EQUAL(bucket.transfers, orig_val + 1);
+
+    generate_block();
+
+    BOOST_REQUIRE_EQUAL(bucket.transfers, orig_val + 1);
+
+    // the block that creates a bucket is counted once
+    const uint32_t seconds = 60;
+    const fc::time_point_sec open((db.head_block_time().sec_since_epoch() / seconds) * seconds);
+    while (db.head_block_time() < open + seconds)
+        generate_block();
+
+    const auto& bucket_idx = db.get_index<bucket_index>().indices().get<common_statistics::by_bucket>();
+    auto itr = bucket_idx.find(boost::make_tuple(seconds, open + seconds));
+    BOOST_REQUIRE(itr != bucket_idx.end());
+    BOOST_REQUIRE_EQUAL(itr->blocks, 1u);
+}
+
+SCORUM_TEST_CASE(timeline_accumulates_totals_test)
+{
+    const bucket_object& bucket = get_lifetime_bucket();
+
+    auto orig_val = get_last_checkpoint().transfers;
+
+    transfer_operation op;
+    op.from = TEST_INIT_DELEGATE_NAME;
+    op.to = alice;
+    op.amount = asset(1, SCORUM_SYMBOL);
+
+    push_operation(op);
+
+    BOOST_REQUIRE_EQUAL(get_last_checkpoint().transfers, orig_val + 1);
+    BOOST_REQUIRE_EQUAL(get_last_checkpoint().transfers, bucket.transfers);
+    BOOST_REQUIRE_EQUAL(get_last_checkpoint().scorum_transferred, bucket.scorum_transferred);
+}
+
 SCORUM_TEST_CASE(transfers_to_scorumpower_stat_test)
 {
     const bucket_object& bucket = get_lifetime_bucket();
@@ -317,3 +380,125 @@ SCORUM_TEST_CASE(scorumpower_transfered_stat_test)
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+namespace blockchain_stat {
+
+struct stat_api_fixture : public stat_database_fixture
+{
+    stat_api_fixture()
+        : stats_api_ctx(app, "chain_stats_api", std::make_shared<scorum::app::api_session_data>())
+        , stats_api(stats_api_ctx)
+    {
+    }
+
+    void configure_timeline(uint32_t resolution, uint32_t history)
+    {
+        boost::program_options::variables_map options;
+        options.insert(std::make_pair("chain-stats-timeline-resolution",
+                                      boost::program_options::variable_value(resolution, false)));
+        options.insert(
+            std::make_pair("chain-stats-timeline-history", boost::program_options::variable_value(history, false)));
+
+        db_stat->plugin_initialize(options);
+    }
+
+    void generate_until(const fc::time_point_sec& time)
+    {
+        while (db.head_block_time() < time)
+            generate_block();
+    }
+
+    /// transfers i + 1 SCR in the i-th of the minutes that follow the returned time
+    fc::time_point_sec transfer_every_minute(uint32_t minutes)
+    {
+        const fc::time_point_sec start((db.head_block_time().sec_since_epoch() / minute + 1) * minute);
+
+        for (uint32_t i = 0; i < minutes; ++i)
+        {
+            generate_until(start + i * minute);
+
+            transfer_operation op;
+            op.from = TEST_INIT_DELEGATE_NAME;
+            op.to = alice;
+            op.amount = asset(i + 1, SCORUM_SYMBOL);
+
+            push_operation(op);
+        }
+
+        generate_until(start + minutes * minute);
+
+        return start;
+    }
+
+    const uint32_t minute = 60;
+
+    scorum::app::api_context stats_api_ctx;
+    blockchain_statistics_api stats_api;
+};
+} // namespace blockchain_stat
+
+BOOST_FIXTURE_TEST_SUITE(statistic_api_tests, blockchain_stat::stat_api_fixture)
+
+SCORUM_TEST_CASE(interval_from_timeline_equals_interval_from_buckets_test)
+{
+    const fc::time_point_sec start = transfer_every_minute(3);
+    const fc::time_point_sec end = start + 3 * minute;
+
+    const statistics timeline = stats_api.get_stats_for_interval(start, end);
+
+    configure_timeline(0, 0);
+
+    const statistics buckets = stats_api.get_stats_for_interval(start, end);
+
+    BOOST_CHECK_EQUAL(timeline.transfers, 3u);
+    BOOST_CHECK_EQUAL(timeline.scorum_transferred, share_type(1 + 2 + 3));
+
+    BOOST_CHECK_EQUAL(timeline.blocks, buckets.blocks);
+    BOOST_CHECK_EQUAL(timeline.transactions, buckets.transactions);
+    BOOST_CHECK_EQUAL(timeline.operations, buckets.operations);
+    BOOST_CHECK_EQUAL(timeline.bandwidth, buckets.bandwidth);
+    BOOST_CHECK_EQUAL(timeline.transfers, buckets.transfers);
+    BOOST_CHECK_EQUAL(timeline.scorum_transferred, buckets.scorum_transferred);
+}
+
+SCORUM_TEST_CASE(interval_bounds_are_rounded_up_to_timeline_resolution_test)
+{
+    const fc::time_point_sec start = transfer_every_minute(4);
+
+    // read as [start + 1 minute, start + 3 minutes)
+    const statistics rounded = stats_api.get_stats_for_interval(start + 1, start + 2 * minute + 1);
+
+    BOOST_CHECK_EQUAL(rounded.transfers, 2u);
+    BOOST_CHECK_EQUAL(rounded.scorum_transferred, share_type(2 + 3));
+}
+
+SCORUM_TEST_CASE(interval_before_first_checkpoint_test)
+{
+    transfer_every_minute(2);
+
+    const statistics lifetime = stats_api.get_lifetime_stats();
+    const statistics all = stats_api.get_stats_for_interval(fc::time_point_sec(), db.head_block_time() + minute);
+
+    BOOST_CHECK_EQUAL(all.blocks, lifetime.blocks);
+    BOOST_CHECK_EQUAL(all.transfers, lifetime.transfers);
+    BOOST_CHECK_EQUAL(all.scorum_transferred, lifetime.scorum_transferred);
+}
+
+SCORUM_TEST_CASE(pruned_timeline_falls_back_to_buckets_test)
+{
+    configure_timeline(minute, 2);
+
+    const fc::time_point_sec start = transfer_every_minute(4);
+
+    const auto& timeline_idx = db.get_index<timeline_index>().indices().get<by_open>();
+    BOOST_REQUIRE_EQUAL(timeline_idx.size(), 2u);
+    BOOST_CHECK(timeline_idx.begin()->id != timeline_id_type(0));
+    BOOST_CHECK(timeline_idx.begin()->open > start);
+
+    const statistics pruned = stats_api.get_stats_for_interval(start, start + 2 * minute);
+
+    BOOST_CHECK_EQUAL(pruned.transfers, 2u);
+    BOOST_CHECK_EQUAL(pruned.scorum_transferred, share_type(1 + 2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
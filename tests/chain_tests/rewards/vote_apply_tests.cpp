@@ -10,6 +10,8 @@
 #include <scorum/chain/schema/comment_objects.hpp>
 #include <scorum/chain/schema/dynamic_global_property_object.hpp>
 
+#include <scorum/chain/operation_notification.hpp>
+
 #include "database_default_integration.hpp"
 
 using namespace scorum;
@@ -716,6 +718,54 @@ SCORUM_TEST_CASE(failure_with_a_new_vote_within_lockout_period_check)
     SCORUM_REQUIRE_THROW(db.push_transaction(tx, 0), fc::assert_exception);
 }
 
+SCORUM_TEST_CASE(curation_rewards_for_comments_paid_in_one_block_check)
+{
+    // comments of alice and bob are created in the same block to be paid in the same block
+    for (const std::string author : { "alice", "bob" })
+    {
+        signed_transaction tx;
+        tx.operations.push_back(comment_ops[author]);
+        tx.set_expiration(global_property_service.head_block_time() + SCORUM_MAX_TIME_UNTIL_EXPIRATION);
+        tx.sign(private_keys[author], db.get_chain_id());
+
+        BOOST_REQUIRE_NO_THROW(db.push_transaction(tx, 0));
+    }
+
+    generate_block();
+
+    const auto& alice_comment = comment_service.get("alice", std::string("foo"));
+    const auto& bob_comment = comment_service.get("bob", std::string("foo"));
+
+    BOOST_REQUIRE(alice_comment.cashout_time == bob_comment.cashout_time);
+
+    vote("sam", "alice", 100);
+    vote("sam", "bob", 100);
+
+    generate_blocks(alice_comment.cashout_time - SCORUM_BLOCK_INTERVAL);
+
+    const account_object& sam = account_service.get_account("sam");
+    asset sam_sp_before = sam.scorumpower;
+
+    std::vector<curation_reward_operation> rewards;
+    db.post_apply_operation.connect([&](const operation_notification& note) {
+        if (note.op.which() == operation::tag<curation_reward_operation>::value)
+            rewards.push_back(note.op.get<curation_reward_operation>());
+    });
+
+    generate_block();
+
+    BOOST_REQUIRE_NO_THROW(validate_database());
+
+    BOOST_REQUIRE_EQUAL(rewards.size(), size_t(2));
+
+    BOOST_CHECK_EQUAL(rewards[0].curator, "sam");
+    BOOST_CHECK_EQUAL(rewards[0].comment_author, "alice");
+    BOOST_CHECK_EQUAL(rewards[1].curator, "sam");
+    BOOST_CHECK_EQUAL(rewards[1].comment_author, "bob");
+
+    BOOST_REQUIRE_EQUAL(sam.scorumpower - sam_sp_before, rewards[0].reward + rewards[1].reward);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif
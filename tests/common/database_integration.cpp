@@ -79,7 +79,7 @@ void database_integration_fixture::open_database(const genesis_state_type& genes
         }
 
         db_plugin = app.register_plugin<scorum::plugin::debug_node::debug_node_plugin>();
-        auto wit_plugin = app.register_plugin<scorum::witness::witness_plugin>();
+        wit_plugin = app.register_plugin<scorum::witness::witness_plugin>();
 
         boost::program_options::variables_map options;
 
@@ -7,6 +7,7 @@
 #include <fc/smart_ref_impl.hpp>
 
 #include <scorum/plugins/debug_node/debug_node_plugin.hpp>
+#include <scorum/witness/witness_plugin.hpp>
 
 #include <graphene/utilities/key_conversion.hpp>
 
@@ -59,6 +60,7 @@ public:
     const uint32_t default_skip;
 
     std::shared_ptr<scorum::plugin::debug_node::debug_node_plugin> db_plugin;
+    std::shared_ptr<scorum::witness::witness_plugin> wit_plugin;
 
     fc::optional<fc::temp_directory> data_dir;
 };
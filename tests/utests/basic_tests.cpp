@@ -122,6 +122,28 @@ BOOST_AUTO_TEST_CASE(asset_operation_test)
     BOOST_CHECK_THROW(asset(3, SCORUM_SYMBOL) - asset(1, SP_SYMBOL), fc::assert_exception);
 }
 
+BOOST_AUTO_TEST_CASE(operation_metadata_test)
+{
+    BOOST_CHECK(get_operation_metadata(transfer_operation()).is_market);
+    BOOST_CHECK(!get_operation_metadata(transfer_operation()).is_virtual);
+    BOOST_CHECK(!get_operation_metadata(vote_operation()).is_market);
+    BOOST_CHECK(get_operation_metadata(author_reward_operation()).is_virtual);
+
+    BOOST_CHECK(is_market_operation(transfer_to_scorumpower_operation()));
+    BOOST_CHECK(is_virtual_operation(author_reward_operation()));
+    BOOST_CHECK(!is_virtual_operation(comment_operation()));
+
+    BOOST_CHECK_EQUAL(get_operation_tag("scorum::protocol::transfer_operation"),
+                      (int)operation::tag<transfer_operation>::value);
+    BOOST_CHECK_EQUAL(get_operation_tag("unknown_operation"), -1);
+
+    operation_mask mask = make_operation_mask<vote_operation, comment_operation>();
+    BOOST_CHECK(mask.test(operation(vote_operation()).which()));
+    BOOST_CHECK(mask.test(operation(comment_operation()).which()));
+    BOOST_CHECK(!mask.test(operation(transfer_operation()).which()));
+    BOOST_CHECK_EQUAL(mask.count(), 2u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(basic_tests)